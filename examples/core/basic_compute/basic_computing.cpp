@@ -57,12 +57,11 @@ BasicComputing::BasicComputing() {
 
   m_ptrUniformBuffer =
       plc::createUniqueUniformBuffer(*m_ptrContext, sizeof(float_t));
-  const auto uniform_mapped_address =
-      m_ptrUniformBuffer->mapMemory(*m_ptrContext);
-  std::fill_n(reinterpret_cast<float_t*>(uniform_mapped_address),
-              m_ptrUniformBuffer->getSize() / sizeof(float_t),
+  const auto uniform_span = m_ptrUniformBuffer->getMappedSpan();
+  std::fill_n(reinterpret_cast<float_t*>(uniform_span.data()),
+              uniform_span.size_bytes() / sizeof(float_t),
               3.14f);
-  m_ptrUniformBuffer->unmapMemory(*m_ptrContext);
+  m_ptrUniformBuffer->flushRange();
 
   m_ptrInputStorageBuffer = plc::createUniqueStorageBuffer(
       *m_ptrContext, plc::TransferType::TransferDst, sizeof(uint32_t) * 1024u);
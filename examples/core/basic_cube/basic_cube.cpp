@@ -44,7 +44,6 @@ BasicCube::BasicCube() {
 
   m_ptrUniformBuffer = std::make_unique<plc::gpu::Buffer>(
       plc::createUniformBuffer(*m_ptrContext, sizeof(CubePosition)));
-  m_ptrCubePositionMapping = m_ptrUniformBuffer->mapMemory(*m_ptrContext);
 
   const auto shader_result = constructShaderResources();
   if (!shader_result.isOk()) {
@@ -126,9 +125,10 @@ void BasicCube::run() {
         glm::rotate(m_ptrCubePosition->model,
                     glm::radians(360 * glm::sin(accum_count) / 100.0f),
                     glm::vec3(0.5f, 1.0f, 0.0f));
-    std::memcpy(m_ptrCubePositionMapping,
+    std::memcpy(m_ptrUniformBuffer->getMappedSpan().data(),
                 reinterpret_cast<void*>(m_ptrCubePosition.get()),
                 sizeof(CubePosition));
+    m_ptrUniformBuffer->flushRange(0u, sizeof(CubePosition));
 
     const auto& ptr_swapchain = m_ptrContext->getPtrSwapchain();
     const auto update_result =
@@ -180,9 +180,6 @@ void BasicCube::run() {
 
     ptr_swapchain->updateFrameSyncIndex();
   }
-
-  m_ptrCubePositionMapping = nullptr;
-  m_ptrUniformBuffer->unmapMemory(*m_ptrContext);
 }
 
 plc::VoidResult BasicCube::constructShaderResources() {
@@ -33,7 +33,6 @@ class BasicCube {
 
   std::unique_ptr<plc::gpu::Buffer> m_ptrUniformBuffer;
   std::unique_ptr<CubePosition> m_ptrCubePosition;
-  void* m_ptrCubePositionMapping;
 
   plc::ShaderModuleMap m_shaderModuleMap;
 
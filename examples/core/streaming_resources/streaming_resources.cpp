@@ -61,11 +61,12 @@ StreamingResources::StreamingResources()
   std::println("Command Drivers created successfully.");
 
   // Initialize Timeline Semaphore management variables
+  m_currentTimelineSemaphore =
+      std::make_unique<plc::gpu::TimelineSemaphore>(*m_ptrContext);
   m_currentSemaphoreValue = 0u;
-  // Timeline Semaphore will be created on first use
 
-  // Create frame-specific vertex buffers and staging buffers (increased size
-  // for multiple triangles)
+  // Create frame-specific vertex buffers (increased size for multiple
+  // triangles) and one staging ring shared by every frame
   std::println("Creating frame-specific buffers...");
   const size_t frame_count = m_ptrContext->getPtrSwapchain()->getImageCount();
   const size_t buffer_size =
@@ -73,9 +74,10 @@ StreamingResources::StreamingResources()
   for (size_t idx = 0u; idx < frame_count; idx += 1u) {
     m_ptrVertexBuffers.push_back(
         plc::createUniqueVertexBuffer(*m_ptrContext, buffer_size));
-    m_stagingBuffers.push_back(
-        plc::createStagingBufferToGPU(*m_ptrContext, buffer_size));
   }
+  // Two full uploads in flight are enough; the ring blocks if the GPU lags
+  m_ptrStagingRing = std::make_unique<plc::gpu::StagingRing>(
+      *m_ptrContext, *m_currentTimelineSemaphore, buffer_size * 2u);
   std::println("Buffers created successfully.");
 
   std::println("Constructing shader resources...");
@@ -316,35 +318,16 @@ plc::VoidResult StreamingResources::updateVertexData() {
   const auto& ptr_swapchain = m_ptrContext->getPtrSwapchain();
   const uint32_t frame_index = ptr_swapchain->getFrameSyncIndex();
 
-  // Use frame-specific staging buffer, vertex buffer, and transfer command
-  // driver
-  auto& staging_buffer = m_stagingBuffers[frame_index];
+  // Use frame-specific vertex buffer and transfer command driver
   auto& vertex_buffer = m_ptrVertexBuffers[frame_index];
   auto& transfer_driver = m_ptrTransferCommandDriver[frame_index];
 
-  // Copy vertex data to staging buffer
-  size_t vertex_data_size = vertices.size() * sizeof(Vertex);
-  auto mapped_address = staging_buffer.mapMemory(*m_ptrContext);
-  std::memcpy(mapped_address, vertices.data(), vertex_data_size);
-  staging_buffer.unmapMemory(*m_ptrContext);
-
-  // Create Timeline Semaphore if needed, or reuse existing one
-  if (!m_currentTimelineSemaphore) {
-    m_currentTimelineSemaphore =
-        std::make_unique<plc::gpu::TimelineSemaphore>(*m_ptrContext);
-    m_currentSemaphoreValue = 0u;  // Initial state
-  }
-
-  // Check if timeline value is getting too large and needs reset
-  constexpr uint64_t TIMELINE_RESET_THRESHOLD = 1000000u;  // 1 million
-  if (m_currentSemaphoreValue > TIMELINE_RESET_THRESHOLD) {
-    std::println(
-        "Timeline Semaphore value ({}) exceeded threshold, recreating...",
-        m_currentSemaphoreValue);
-    m_currentTimelineSemaphore =
-        std::make_unique<plc::gpu::TimelineSemaphore>(*m_ptrContext);
-    m_currentSemaphoreValue = 0u;  // Reset to initial state
-  }
+  // Copy vertex data into a region of the staging ring
+  const size_t vertex_data_size = vertices.size() * sizeof(Vertex);
+  PANDORA_TRY_ASSIGN(
+      staging_region,
+      m_ptrStagingRing->reserve(*m_ptrContext, vertex_data_size));
+  std::memcpy(staging_region.data.data(), vertices.data(), vertex_data_size);
 
   // Increment timeline value for this frame
   m_currentSemaphoreValue += 1u;
@@ -352,7 +335,12 @@ plc::VoidResult StreamingResources::updateVertexData() {
   // Use transfer command to copy from staging to vertex buffer
   const auto command_buffer = transfer_driver->getTransfer();
   command_buffer.begin();
-  command_buffer.copyBuffer(staging_buffer, *vertex_buffer);
+  command_buffer.copyBufferRegions(
+      staging_region.buffer.get(),
+      *vertex_buffer,
+      {plc::BufferCopyRegion{}
+           .setSrcOffset(staging_region.offset)
+           .setSize(vertex_data_size)});
 
   // Add buffer barrier to ensure transfer is complete before graphics reads
   const auto queue_family_indices = std::make_pair(
@@ -375,6 +363,9 @@ plc::VoidResult StreamingResources::updateVertexData() {
 
   command_buffer.end();
 
+  // The region is recycled once the timeline reaches this frame's value
+  m_ptrStagingRing->commit(m_currentSemaphoreValue);
+
   // Submit transfer command with Timeline Semaphore synchronization
   transfer_driver->submit(
       plc::SubmitSemaphoreGroup{}
@@ -37,7 +37,6 @@ class StreamingResources {
 
   // Frame-specific vertex buffers to avoid resource contention
   std::vector<std::unique_ptr<plc::gpu::Buffer>> m_ptrVertexBuffers;
-  std::vector<plc::gpu::Buffer> m_stagingBuffers;
   plc::ShaderModuleMap m_shaderModuleMap;
 
   std::unique_ptr<plc::Pipeline> m_ptrPipeline;
@@ -48,6 +47,10 @@ class StreamingResources {
   std::unique_ptr<plc::gpu::TimelineSemaphore> m_currentTimelineSemaphore;
   uint64_t m_currentSemaphoreValue;
 
+  // Staging ring shared by all frames; regions are recycled once the
+  // timeline semaphore passes the value of the upload that read them
+  std::unique_ptr<plc::gpu::StagingRing> m_ptrStagingRing;
+
   // Triangle generation state
   std::vector<Vertex> m_activeTriangles;
   std::vector<TriangleInfo> m_triangleInfos;
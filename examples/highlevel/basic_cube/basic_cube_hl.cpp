@@ -43,7 +43,6 @@ BasicCubeHL::BasicCubeHL() {
 
   m_ptrUniformBuffer = std::make_unique<plc::gpu::Buffer>(
       plc::createUniformBuffer(*m_ptrContext, sizeof(CubePosition)));
-  m_ptrCubePositionMapping = m_ptrUniformBuffer->mapMemory(*m_ptrContext);
 
   const auto shader_result = constructShaderResources();
   if (!shader_result.isOk()) {
@@ -72,9 +71,6 @@ BasicCubeHL::~BasicCubeHL() {
   if (m_ptrContext) {
     m_ptrContext->getPtrDevice()->waitIdle();
   }
-  if (m_ptrUniformBuffer && m_ptrCubePositionMapping) {
-    m_ptrUniformBuffer->unmapMemory(*m_ptrContext);
-  }
 }
 
 void BasicCubeHL::run() {
@@ -123,9 +119,10 @@ void BasicCubeHL::updateUniforms() {
       glm::rotate(m_ptrCubePosition->model,
                   glm::radians(360 * glm::sin(accum_count) / 100.0f),
                   glm::vec3(0.5f, 1.0f, 0.0f));
-  std::memcpy(m_ptrCubePositionMapping,
+  std::memcpy(m_ptrUniformBuffer->getMappedSpan().data(),
               reinterpret_cast<void*>(m_ptrCubePosition.get()),
               sizeof(CubePosition));
+  m_ptrUniformBuffer->flushRange(0u, sizeof(CubePosition));
 }
 
 plc::VoidResult BasicCubeHL::constructShaderResources() {
@@ -36,7 +36,6 @@ class BasicCubeHL {
 
   std::unique_ptr<plc::gpu::Buffer> m_ptrUniformBuffer;
   std::unique_ptr<CubePosition> m_ptrCubePosition;
-  void* m_ptrCubePositionMapping = nullptr;
 
   plc::ShaderModuleMap m_shaderModuleMap;
 
@@ -18,11 +18,11 @@ SimpleImageComputingHL::SimpleImageComputingHL() {
 
   m_ptrUniformBuffer =
       plc::createUniqueUniformBuffer(*m_ptrContext, sizeof(float_t));
-  const auto mapped_address = m_ptrUniformBuffer->mapMemory(*m_ptrContext);
-  std::fill_n(reinterpret_cast<float_t*>(mapped_address),
-              m_ptrUniformBuffer->getSize() / sizeof(float_t),
+  const auto uniform_span = m_ptrUniformBuffer->getMappedSpan();
+  std::fill_n(reinterpret_cast<float_t*>(uniform_span.data()),
+              uniform_span.size_bytes() / sizeof(float_t),
               5.0f);
-  m_ptrUniformBuffer->unmapMemory(*m_ptrContext);
+  m_ptrUniformBuffer->flushRange();
 
   initializeImageResources();
   const auto shader_result = constructShaderResources();
@@ -9,6 +9,7 @@
 
 #include "pandora/core/error.hpp"
 #include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
 #include "pandora/core/io.hpp"
 #include "pandora/core/ui.hpp"
 
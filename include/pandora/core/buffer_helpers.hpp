@@ -62,6 +62,8 @@ std::unique_ptr<gpu::Buffer> createUniqueStagingBufferFromGPU(
 
 /// @brief Create storage buffer for compute shader operations
 /// Creates a buffer that can be read and written by compute shaders.
+/// Uses host-visible device-local memory when
+/// MemoryAllocator::isDirectWriteAvailable() so uploads can skip staging.
 /// @param context GPU context for device access
 /// @param transfer_type Transfer capabilities needed for this buffer
 /// @param size Buffer size in bytes
@@ -98,6 +100,8 @@ std::unique_ptr<gpu::Buffer> createUniqueUniformBuffer(
 
 /// @brief Create vertex buffer for vertex data
 /// Creates a buffer optimized for storing vertex attribute data.
+/// Uses host-visible device-local memory when
+/// MemoryAllocator::isDirectWriteAvailable() so uploads can skip staging.
 /// @param context GPU context for device access
 /// @param size Buffer size in bytes
 /// @return Buffer object configured for vertex data
@@ -114,6 +118,8 @@ std::unique_ptr<gpu::Buffer> createUniqueVertexBuffer(
 
 /// @brief Create index buffer for indexed rendering
 /// Creates a buffer optimized for storing vertex indices for indexed drawing.
+/// Uses host-visible device-local memory when
+/// MemoryAllocator::isDirectWriteAvailable() so uploads can skip staging.
 /// @param context GPU context for device access
 /// @param size Buffer size in bytes
 /// @return Buffer object configured for index data
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 #include <vulkan/vulkan.hpp>
@@ -37,6 +39,9 @@ class Image;
 class BufferBarrier;
 class ImageBarrier;
 class DescriptorSet;
+class BufferDescription;
+class ImageDescription;
+class BindlessHeap;
 class TimelineSemaphore;
 class BinarySemaphore;
 }  // namespace pandora::core::gpu
@@ -128,11 +133,44 @@ class CommandBuffer {
   void bindPipeline(const Pipeline& pipeline) const;
 
   /// @brief Bind descriptor set to pipeline
+  /// @details The set is bound at its own set index, leaving the other sets
+  /// of the pipeline layout bound as they are.
   /// @param pipeline Pipeline that owns the descriptor set layout
   /// @param descriptor_set Descriptor set containing resource bindings
   void bindDescriptorSet(const Pipeline& pipeline,
                          const gpu::DescriptorSet& descriptor_set) const;
 
+  /// @brief Bind descriptor set with dynamic offsets
+  /// @param pipeline Pipeline that owns the descriptor set layout
+  /// @param descriptor_set Descriptor set containing resource bindings
+  /// @param dynamic_offsets One offset per dynamic uniform/storage binding, in
+  /// binding order
+  void bindDescriptorSet(const Pipeline& pipeline,
+                         const gpu::DescriptorSet& descriptor_set,
+                         const std::vector<uint32_t>& dynamic_offsets) const;
+
+  /// @brief Write descriptors for one set directly into the command buffer
+  /// @details No DescriptorSet or pool is involved: bindings are recorded with
+  /// the command and stay valid until the next push or bind. The pipeline must
+  /// be created with a DescriptorSetLayoutType::PushDescriptor layout.
+  /// @param pipeline Pipeline whose set_index is a push-descriptor layout
+  /// @param buffer_descriptions Buffer descriptors to push
+  /// @param image_descriptions Image descriptors to push
+  /// @param set_index Set the descriptors are written to
+  void pushDescriptors(
+      const Pipeline& pipeline,
+      const std::vector<gpu::BufferDescription>& buffer_descriptions,
+      const std::vector<gpu::ImageDescription>& image_descriptions,
+      uint32_t set_index = 0u) const;
+
+  /// @brief Bind a bindless heap's descriptor set as set 0
+  /// @details Bind once per command buffer; draws then select resources by
+  /// the indices passed with pushIndices().
+  /// @param pipeline Pipeline created with the heap's set layout
+  /// @param bindless_heap Heap holding the resource arrays
+  void bindDescriptorSet(const Pipeline& pipeline,
+                         const gpu::BindlessHeap& bindless_heap) const;
+
   /// @brief Register push constants to pipeline
   /// Push constants provide a fast way to pass small amounts of data to
   /// shaders.
@@ -145,6 +183,26 @@ class CommandBuffer {
                      uint32_t offset,
                      const std::vector<float_t>& data) const;
 
+  /// @brief Register raw push constant bytes to pipeline
+  /// @param pipeline Pipeline to receive push constants
+  /// @param dst_stages Shader stages that will use the push constants
+  /// @param offset Byte offset into push constant range
+  /// @param data Push constant data as bytes
+  void pushConstants(const Pipeline& pipeline,
+                     const std::vector<ShaderStage>& dst_stages,
+                     uint32_t offset,
+                     std::span<const std::byte> data) const;
+
+  /// @brief Push bindless resource indices as push constants
+  /// @param pipeline Pipeline to receive push constants
+  /// @param dst_stages Shader stages that will use the indices
+  /// @param offset Byte offset into push constant range
+  /// @param indices Indices returned by BindlessHeap register functions
+  void pushIndices(const Pipeline& pipeline,
+                   const std::vector<ShaderStage>& dst_stages,
+                   uint32_t offset,
+                   const std::vector<uint32_t>& indices) const;
+
   /// @brief Reset GPU command buffer
   /// Clears all recorded commands, preparing the buffer for new recording.
   void resetCommands() const;
@@ -179,6 +237,15 @@ class TransferCommandBuffer : public CommandBuffer {
   void copyBuffer(const gpu::Buffer& staging_buffer,
                   const gpu::Buffer& dst_buffer) const;
 
+  /// @brief Copy several ranges between two buffers in one command
+  /// Records a single vkCmdCopyBuffer2 with one region per entry.
+  /// @param src_buffer Source buffer (typically a staging buffer)
+  /// @param dst_buffer Destination buffer
+  /// @param regions Ranges to copy
+  void copyBufferRegions(const gpu::Buffer& src_buffer,
+                         const gpu::Buffer& dst_buffer,
+                         const std::vector<BufferCopyRegion>& regions) const;
+
   /// @brief Copy CPU staging buffer data to GPU image
   /// @param buffer CPU buffer containing image data
   /// @param image GPU local image destination
@@ -12,14 +12,23 @@
 #include "types.hpp"
 
 // GPU modules
+#include "gpu/allocator.hpp"
 #include "gpu/barrier.hpp"
+#include "gpu/bindless_heap.hpp"
 #include "gpu/buffer.hpp"
 #include "gpu/config.hpp"
 #include "gpu/context.hpp"
+#include "gpu/deletion_queue.hpp"
 #include "gpu/descriptor.hpp"
+#include "gpu/descriptor_allocator.hpp"
 #include "gpu/device.hpp"
 #include "gpu/fence.hpp"
 #include "gpu/image.hpp"
+#include "gpu/layout_cache.hpp"
+#include "gpu/memory_stats.hpp"
+#include "gpu/pipeline_cache_store.hpp"
 #include "gpu/semaphore.hpp"
 #include "gpu/shader.hpp"
+#include "gpu/staging_ring.hpp"
 #include "gpu/swapchain.hpp"
+#include "gpu/view_cache.hpp"
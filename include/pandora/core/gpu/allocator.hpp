@@ -0,0 +1,355 @@
+/*
+ * allocator.hpp - Device memory allocator for Pandolabo Vulkan C++ wrapper
+ *
+ * This header contains the MemoryAllocator class which sub-allocates buffers
+ * and images from large per-memory-type device memory blocks, and the
+ * MemoryAllocation handle that owns one such sub-allocation.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "../types.hpp"
+#include "memory_stats.hpp"
+
+namespace pandora::core::gpu {
+
+class Device;
+class MemoryAllocator;
+
+/// @brief Resource layout class used to honour bufferImageGranularity
+/// @details Linear resources (buffers) and optimal-tiling resources (images)
+/// must not share a bufferImageGranularity page. The allocator keeps them in
+/// separate blocks when the device reports a granularity larger than 1.
+enum class AllocationKind {
+  Linear = 0u,
+  Optimal,
+};
+
+/// @brief Memory property flags used to rank memory types
+/// @details Types lacking a required flag are never chosen. Among the others,
+/// every preferred flag raises the score and every avoided flag lowers it, so
+/// e.g. CpuToGpu lands in device-local host-visible memory when there is some
+/// and in plain host-visible memory otherwise.
+struct MemoryTypeRequest {
+  vk::MemoryPropertyFlags required;
+  vk::MemoryPropertyFlags preferred;
+  vk::MemoryPropertyFlags avoided;
+};
+
+/// @brief Free-list bookkeeping for one device memory block
+/// @details This class only tracks offsets; it never touches Vulkan objects.
+/// Free ranges are kept sorted by offset and adjacent ranges are merged on
+/// free, so fragmentation stays bounded by the live allocations.
+class MemoryBlockMetadata {
+ private:
+  vk::DeviceSize m_size = 0u;
+  vk::DeviceSize m_freeSize = 0u;
+  std::map<vk::DeviceSize, vk::DeviceSize> m_freeRanges;  // offset -> size
+
+ public:
+  /// @brief Construct metadata for a block with the whole range free
+  /// @param size Block size in bytes
+  explicit MemoryBlockMetadata(vk::DeviceSize size);
+
+  /// @brief Reserve a range from the block (first fit)
+  /// @param size Requested size in bytes
+  /// @param alignment Required offset alignment (power of two)
+  /// @return Offset of the reserved range, or std::nullopt if it does not fit
+  std::optional<vk::DeviceSize> allocate(vk::DeviceSize size,
+                                         vk::DeviceSize alignment);
+
+  /// @brief Return a range previously reserved by allocate()
+  /// @param offset Offset returned by allocate()
+  /// @param size Size passed to allocate()
+  void free(vk::DeviceSize offset, vk::DeviceSize size);
+
+  /// @brief Get block size
+  /// @return Block size in bytes
+  auto getSize() const {
+    return m_size;
+  }
+
+  /// @brief Get total free bytes (may be fragmented)
+  /// @return Free bytes in the block
+  auto getFreeSize() const {
+    return m_freeSize;
+  }
+
+  /// @brief Check whether no range is reserved
+  /// @return True if the block is completely free
+  bool isEmpty() const {
+    return m_freeSize == m_size;
+  }
+};
+
+/// @brief One device memory object owned by the allocator
+struct MemoryBlock {
+  vk::UniqueDeviceMemory ptr_memory;
+  MemoryBlockMetadata metadata;
+  uint32_t memory_type_index = 0u;
+  AllocationKind kind = AllocationKind::Linear;
+  bool is_dedicated = false;
+  void* ptr_mapped = nullptr;
+  uint32_t map_count = 0u;
+};
+
+/// @brief Sub-allocation handle returned by MemoryAllocator
+/// @details Move-only RAII handle. The range is returned to its block when the
+/// handle is destroyed; dedicated allocations release their memory object.
+class MemoryAllocation {
+ private:
+  MemoryAllocator* m_ptrAllocator = nullptr;
+  MemoryBlock* m_ptrBlock = nullptr;
+  vk::DeviceSize m_offset = 0u;
+  vk::DeviceSize m_size = 0u;
+  void* m_ptrPersistentMapping = nullptr;
+
+ public:
+  MemoryAllocation() = default;
+
+  /// @brief Construct allocation handle (used by MemoryAllocator)
+  /// @param allocator Owning allocator
+  /// @param block Block the range was carved from
+  /// @param offset Offset of the range inside the block
+  /// @param size Size of the range in bytes
+  MemoryAllocation(MemoryAllocator* allocator,
+                   MemoryBlock* block,
+                   vk::DeviceSize offset,
+                   vk::DeviceSize size)
+      : m_ptrAllocator(allocator),
+        m_ptrBlock(block),
+        m_offset(offset),
+        m_size(size) {}
+  ~MemoryAllocation();
+
+  // Rule of Five
+  MemoryAllocation(const MemoryAllocation&) = delete;
+  MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+  MemoryAllocation(MemoryAllocation&& other) noexcept;
+  MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+
+  /// @brief Get device memory the range lives in
+  /// @return Vulkan device memory handle
+  vk::DeviceMemory getMemory() const {
+    return m_ptrBlock ? m_ptrBlock->ptr_memory.get() : vk::DeviceMemory{};
+  }
+
+  /// @brief Get offset of the range inside the device memory
+  /// @return Offset in bytes (use for bind and map)
+  auto getOffset() const {
+    return m_offset;
+  }
+
+  /// @brief Get size of the range
+  /// @return Size in bytes
+  auto getSize() const {
+    return m_size;
+  }
+
+  /// @brief Get memory type index of the backing memory
+  /// @return Memory type index
+  uint32_t getMemoryTypeIndex() const {
+    return m_ptrBlock ? m_ptrBlock->memory_type_index : 0u;
+  }
+
+  /// @brief Check whether this allocation owns its memory object
+  /// @return True for dedicated allocations
+  bool isDedicated() const {
+    return m_ptrBlock && m_ptrBlock->is_dedicated;
+  }
+
+  /// @brief Check whether this handle refers to memory
+  /// @return True if the allocation is valid
+  bool isValid() const {
+    return m_ptrBlock != nullptr;
+  }
+
+  /// @brief Map the range into host address space
+  /// @details The whole block is mapped once and shared between all of its
+  /// allocations; each call must be paired with unmap().
+  /// @return Host address of the first byte of this range
+  void* map() const;
+
+  /// @brief Release one map() reference
+  void unmap() const;
+
+  /// @brief Map the range for the lifetime of this allocation
+  /// @details Idempotent. The mapping is released together with the range, so
+  /// callers never pair it with unmap().
+  /// @return Host address of the first byte of this range
+  void* mapPersistently();
+
+  /// @brief Get the address cached by mapPersistently()
+  /// @return Host address, or nullptr if not persistently mapped
+  void* getPersistentMapping() const {
+    return m_ptrPersistentMapping;
+  }
+
+  /// @brief Check whether host writes/reads need explicit flush/invalidate
+  /// @return True if the backing memory type is HOST_COHERENT
+  bool isHostCoherent() const;
+
+  /// @brief Make host writes in a range visible to the device
+  /// @details No-op for host-coherent memory. The range is widened to
+  /// nonCoherentAtomSize as required by vkFlushMappedMemoryRanges.
+  /// @param offset Offset relative to this allocation
+  /// @param size Size in bytes (VK_WHOLE_SIZE for the rest of the range)
+  void flush(vk::DeviceSize offset = 0u,
+             vk::DeviceSize size = VK_WHOLE_SIZE) const;
+
+  /// @brief Make device writes in a range visible to the host
+  /// @details No-op for host-coherent memory. The range is widened to
+  /// nonCoherentAtomSize as required by vkInvalidateMappedMemoryRanges.
+  /// @param offset Offset relative to this allocation
+  /// @param size Size in bytes (VK_WHOLE_SIZE for the rest of the range)
+  void invalidate(vk::DeviceSize offset = 0u,
+                  vk::DeviceSize size = VK_WHOLE_SIZE) const;
+
+  /// @brief Return the range to the allocator
+  void release();
+};
+
+/// @brief Pooled device memory allocator
+/// @details Buffers and images are carved out of large per-memory-type blocks
+/// instead of calling vkAllocateMemory per resource, which keeps the number of
+/// driver allocations far below maxMemoryAllocationCount. Resources larger
+/// than half a block, resources the driver prefers dedicated, and resources
+/// created with AllocationStrategy::Dedicated get their own memory object.
+/// The allocator is owned by Context and must outlive every allocation.
+class MemoryAllocator {
+ public:
+  static constexpr vk::DeviceSize DEFAULT_BLOCK_SIZE =
+      64ull * 1024ull * 1024ull;
+
+ private:
+  vk::Device m_device;
+  vk::PhysicalDeviceMemoryProperties m_memoryProperties{};
+  vk::DeviceSize m_bufferImageGranularity = 1u;
+  vk::DeviceSize m_nonCoherentAtomSize = 1u;
+  vk::DeviceSize m_preferredBlockSize = DEFAULT_BLOCK_SIZE;
+  bool m_hasHostVisibleDeviceLocal = false;
+  bool m_isDirectWriteEnabled = true;
+
+  std::vector<std::vector<std::unique_ptr<MemoryBlock>>> m_pools;
+  std::vector<std::unique_ptr<MemoryBlock>> m_dedicatedBlocks;
+  mutable std::mutex m_mutex;
+
+  uint64_t m_allocationCount = 0u;
+  uint64_t m_freeCount = 0u;
+  uint64_t m_frameStartAllocationCount = 0u;
+  uint64_t m_frameStartFreeCount = 0u;
+  uint64_t m_lastFrameAllocationCount = 0u;
+  uint64_t m_lastFrameFreeCount = 0u;
+
+ public:
+  /// @brief Construct allocator for a device
+  /// @param device GPU device whose memory is managed
+  /// @param preferred_block_size Block size for pooled allocations
+  MemoryAllocator(const Device& device,
+                  vk::DeviceSize preferred_block_size = DEFAULT_BLOCK_SIZE);
+  ~MemoryAllocator();
+
+  // Rule of Five
+  MemoryAllocator(const MemoryAllocator&) = delete;
+  MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+  MemoryAllocator(MemoryAllocator&&) = delete;
+  MemoryAllocator& operator=(MemoryAllocator&&) = delete;
+
+  /// @brief Allocate memory suitable for a buffer
+  /// @param buffer Buffer that will be bound to the allocation
+  /// @param request Required, preferred and avoided memory property flags
+  /// @param strategy Pooled or dedicated allocation
+  /// @return Allocation handle (bind with getMemory()/getOffset())
+  MemoryAllocation allocateForBuffer(vk::Buffer buffer,
+                                     const MemoryTypeRequest& request,
+                                     AllocationStrategy strategy);
+
+  /// @brief Allocate memory suitable for an optimal-tiling image
+  /// @param image Image that will be bound to the allocation
+  /// @param request Required, preferred and avoided memory property flags
+  /// @param strategy Pooled or dedicated allocation
+  /// @return Allocation handle (bind with getMemory()/getOffset())
+  MemoryAllocation allocateForImage(vk::Image image,
+                                    const MemoryTypeRequest& request,
+                                    AllocationStrategy strategy);
+
+  /// @brief Rank the memory types usable for a request
+  /// @param memory_type_bits Allowed types from vk::MemoryRequirements
+  /// @param request Required, preferred and avoided memory property flags
+  /// @return Usable type indices, best first (empty if none qualifies)
+  std::vector<uint32_t> rankMemoryTypes(uint32_t memory_type_bits,
+                                        const MemoryTypeRequest& request) const;
+
+  /// @brief Check whether the main device-local heap is host-visible
+  /// @details True on integrated GPUs, resizable-BAR systems and software
+  /// rasterizers. The small BAR window of discrete GPUs does not count.
+  /// @return True if device-local memory can be mapped without restrictions
+  bool hasHostVisibleDeviceLocalHeap() const {
+    return m_hasHostVisibleDeviceLocal;
+  }
+
+  /// @brief Check whether device-local buffers should be written directly
+  /// @details Buffer helpers then allocate host-visible device-local memory
+  /// and ResourceTransfer memcpys into it instead of going through staging.
+  /// @return True if the heap allows it and direct writes are enabled
+  bool isDirectWriteAvailable() const {
+    return m_hasHostVisibleDeviceLocal && m_isDirectWriteEnabled;
+  }
+
+  /// @brief Enable or disable the direct-write upload path
+  /// @details Disable to force the classic staging path (e.g. for
+  /// benchmarking). Set it before creating resources; buffers keep the memory
+  /// they were created with.
+  /// @param is_enabled False to always upload through staging buffers
+  void setDirectWriteEnabled(bool is_enabled) {
+    m_isDirectWriteEnabled = is_enabled;
+  }
+
+  /// @brief Get number of device memory objects currently held
+  /// @return Pooled block count plus dedicated allocation count
+  size_t getDeviceMemoryCount() const;
+
+  /// @brief Fill per-heap usage and allocation counters into a snapshot
+  /// @param stats Snapshot whose heaps and counters are overwritten
+  void collectStats(MemoryStats& stats) const;
+
+  /// @brief Close the current frame for per-frame allocation counts
+  /// @details Renderer calls this once per frame; call it yourself when
+  /// driving frames with the core API.
+  void markFrame();
+
+ private:
+  friend class MemoryAllocation;
+
+  MemoryAllocation allocate(const vk::MemoryRequirements& requirements,
+                            const MemoryTypeRequest& request,
+                            AllocationKind kind,
+                            bool use_dedicated,
+                            const vk::MemoryDedicatedAllocateInfo& dedicated);
+
+  MemoryAllocation allocateFromType(
+      uint32_t memory_type_idx,
+      const vk::MemoryRequirements& requirements,
+      AllocationKind kind,
+      bool use_dedicated,
+      const vk::MemoryDedicatedAllocateInfo& dedicated);
+
+  vk::DeviceSize getBlockSize(uint32_t memory_type_index) const;
+
+  void free(MemoryBlock* block, vk::DeviceSize offset, vk::DeviceSize size);
+  void* map(MemoryBlock* block, vk::DeviceSize offset);
+  void unmap(MemoryBlock* block);
+  bool isHostCoherent(const MemoryBlock* block) const;
+  vk::MappedMemoryRange getMappedMemoryRange(const MemoryBlock* block,
+                                             vk::DeviceSize offset,
+                                             vk::DeviceSize size) const;
+};
+
+}  // namespace pandora::core::gpu
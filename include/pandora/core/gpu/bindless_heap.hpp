@@ -0,0 +1,144 @@
+/*
+ * bindless_heap.hpp - Bindless descriptor heap for Pandolabo Vulkan C++
+ * wrapper
+ *
+ * This header contains the BindlessHeap class which exposes large,
+ * partially bound descriptor arrays indexed from shaders by push constants.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "../error.hpp"
+#include "../types.hpp"
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Context;
+class Buffer;
+class ImageView;
+class Sampler;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Descriptor arrays held by BindlessHeap
+/// @details The value is also the binding number in the heap's set.
+enum class BindlessResource {
+  SampledImage = 0u,  ///< combined image samplers (sampler2D textures[])
+  StorageImage,       ///< storage images (image2D images[])
+  StorageBuffer,      ///< storage buffers (buffer Data {...} buffers[])
+};
+
+/// @brief Bindless descriptor heap built on Vulkan 1.2 descriptor indexing
+/// @details One descriptor set holds an update-after-bind, partially bound
+/// array per BindlessResource kind. Registering a resource writes it into a
+/// free array slot and returns that slot; the index stays valid until
+/// release(). Bind the set once per command buffer and pass indices to
+/// shaders through push constants, so materials no longer need their own
+/// descriptor sets:
+///
+/// @code
+/// layout(set = 0, binding = 0) uniform sampler2D textures[];
+/// layout(push_constant) uniform Indices { uint texture_index; };
+/// ... texture(textures[nonuniformEXT(texture_index)], uv) ...
+/// @endcode
+///
+/// Requires Device::hasDescriptorIndexing().
+class BindlessHeap {
+ private:
+  struct Slots {
+    uint32_t capacity = 0u;
+    uint32_t next_index = 0u;
+    std::vector<uint32_t> free_indices;
+  };
+
+  vk::Device m_device;
+  vk::UniqueDescriptorSetLayout m_ptrDescriptorSetLayout;
+  vk::UniqueDescriptorPool m_ptrDescriptorPool;
+  vk::DescriptorSet m_descriptorSet;  ///< Freed with the pool
+  std::array<Slots, 3u> m_slots{};
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct heap with one descriptor array per resource kind
+  /// @details Capacities are clamped to the device's update-after-bind
+  /// limits.
+  /// @param context GPU context
+  /// @param max_sampled_images Capacity of the texture array
+  /// @param max_storage_images Capacity of the storage image array
+  /// @param max_storage_buffers Capacity of the storage buffer array
+  /// @throws vk::FeatureNotPresentError if descriptor indexing is unsupported
+  BindlessHeap(const Context& context,
+               uint32_t max_sampled_images = 4096u,
+               uint32_t max_storage_images = 1024u,
+               uint32_t max_storage_buffers = 4096u);
+  ~BindlessHeap();
+
+  // Rule of Five
+  BindlessHeap(const BindlessHeap&) = delete;
+  BindlessHeap& operator=(const BindlessHeap&) = delete;
+  BindlessHeap(BindlessHeap&&) = delete;
+  BindlessHeap& operator=(BindlessHeap&&) = delete;
+
+  /// @brief Register a sampled texture
+  /// @param image_view Image view to sample
+  /// @param sampler Sampler used with the view
+  /// @param image_layout Layout the image is in when sampled
+  /// @return Index into the SampledImage array
+  [[nodiscard]] Result<uint32_t> registerSampledImage(
+      const ImageView& image_view,
+      const Sampler& sampler,
+      ImageLayout image_layout = ImageLayout::ShaderReadOnlyOptimal);
+
+  /// @brief Register a storage image (always in General layout)
+  /// @param image_view Image view to bind
+  /// @return Index into the StorageImage array
+  [[nodiscard]] Result<uint32_t> registerStorageImage(
+      const ImageView& image_view);
+
+  /// @brief Register a storage buffer or a range of it
+  /// @param buffer Buffer to bind
+  /// @param offset Byte offset of the range
+  /// @param range Byte size of the range (VK_WHOLE_SIZE for the rest)
+  /// @return Index into the StorageBuffer array
+  [[nodiscard]] Result<uint32_t> registerStorageBuffer(
+      const Buffer& buffer,
+      vk::DeviceSize offset = 0u,
+      vk::DeviceSize range = VK_WHOLE_SIZE);
+
+  /// @brief Make an index available for reuse
+  /// @note The GPU must no longer read the slot; defer the call like the
+  /// destruction of the resource itself.
+  /// @param kind Array the index belongs to
+  /// @param index Index returned by a register function
+  void release(BindlessResource kind, uint32_t index);
+
+  /// @brief Get layout of the heap's descriptor set
+  const auto& getDescriptorSetLayout() const {
+    return m_ptrDescriptorSetLayout.get();
+  }
+
+  /// @brief Get the heap's descriptor set
+  const auto& getDescriptorSet() const {
+    return m_descriptorSet;
+  }
+
+  /// @brief Get capacity of one array
+  uint32_t getCapacity(BindlessResource kind) const {
+    return m_slots.at(static_cast<size_t>(kind)).capacity;
+  }
+
+  /// @brief Get number of occupied slots in one array
+  uint32_t getRegisteredCount(BindlessResource kind) const;
+
+ private:
+  Result<uint32_t> acquireIndex(BindlessResource kind);
+};
+
+}  // namespace pandora::core::gpu
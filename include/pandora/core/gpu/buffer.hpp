@@ -8,11 +8,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
 #include "../types.hpp"
+#include "allocator.hpp"
+#include "memory_stats.hpp"
 
 // Forward declarations
 namespace pandora::core::gpu {
@@ -28,8 +32,9 @@ namespace pandora::core::gpu {
 /// float matrix 4x4, float size is 4 bytes, so 4 * 4 * 4 = 64 bytes are needed.
 class Buffer {
  protected:
-  vk::UniqueDeviceMemory m_ptrMemory;
+  MemoryAllocation m_memoryAllocation;
   vk::UniqueBuffer m_ptrBuffer;
+  TrackedResourceToken m_trackingToken;
   size_t m_size = 0u;
 
  public:
@@ -41,11 +46,14 @@ class Buffer {
   /// @param transfer_type Transfer operation type
   /// @param buffer_usages Buffer usage types
   /// @param size Buffer size in bytes
+  /// @param allocation_strategy Pooled (default) or dedicated device memory
   Buffer(const Context& context,
          const MemoryUsage memory_usage,
          const TransferType transfer_type,
          const std::vector<BufferUsage>& buffer_usages,
-         const size_t size);
+         const size_t size,
+         const AllocationStrategy allocation_strategy =
+             AllocationStrategy::Pooled);
   ~Buffer();
 
   // Explicitly delete copy operations to ensure RAII safety
@@ -56,7 +64,8 @@ class Buffer {
   /// @param other Buffer to move from
   Buffer(Buffer&& other) noexcept {
     m_ptrBuffer = std::move(other.m_ptrBuffer);
-    m_ptrMemory = std::move(other.m_ptrMemory);
+    m_memoryAllocation = std::move(other.m_memoryAllocation);
+    m_trackingToken = std::move(other.m_trackingToken);
     m_size = other.m_size;
   }
 
@@ -65,7 +74,8 @@ class Buffer {
   /// @return Reference to this buffer
   Buffer& operator=(Buffer&& other) noexcept {
     m_ptrBuffer = std::move(other.m_ptrBuffer);
-    m_ptrMemory = std::move(other.m_ptrMemory);
+    m_memoryAllocation = std::move(other.m_memoryAllocation);
+    m_trackingToken = std::move(other.m_trackingToken);
     m_size = other.m_size;
     return *this;
   }
@@ -88,14 +98,60 @@ class Buffer {
     return m_size;
   }
 
+  /// @brief Get device memory allocation backing this buffer
+  /// @return Reference to memory allocation
+  const auto& getMemoryAllocation() const {
+    return m_memoryAllocation;
+  }
+
+  /// @brief Check whether the buffer is persistently mapped
+  /// @details CpuOnly, CpuToGpu and GpuToCpu buffers are mapped once at
+  /// creation and stay mapped until destruction.
+  /// @return True if getMappedSpan() is valid
+  bool isPersistentlyMapped() const {
+    return m_memoryAllocation.getPersistentMapping() != nullptr;
+  }
+
+  /// @brief Get persistently mapped buffer memory
+  /// @details Writing or reading through this span is directly reflected in
+  /// GPU memory. Call flushRange() after host writes and invalidateRange()
+  /// before host reads; both are no-ops on host-coherent memory.
+  /// @return Span over the whole buffer, or empty span if not host-visible
+  std::span<std::byte> getMappedSpan() const {
+    if (!isPersistentlyMapped()) {
+      return {};
+    }
+    return {static_cast<std::byte*>(m_memoryAllocation.getPersistentMapping()),
+            m_size};
+  }
+
+  /// @brief Make host writes visible to the device
+  /// @param offset Offset in bytes from the start of the buffer
+  /// @param size Size in bytes (VK_WHOLE_SIZE for the rest of the buffer)
+  void flushRange(size_t offset = 0u, size_t size = VK_WHOLE_SIZE) const {
+    m_memoryAllocation.flush(offset, size == VK_WHOLE_SIZE ? m_size - offset
+                                                            : size);
+  }
+
+  /// @brief Make device writes visible to the host
+  /// @param offset Offset in bytes from the start of the buffer
+  /// @param size Size in bytes (VK_WHOLE_SIZE for the rest of the buffer)
+  void invalidateRange(size_t offset = 0u,
+                       size_t size = VK_WHOLE_SIZE) const {
+    m_memoryAllocation.invalidate(
+        offset, size == VK_WHOLE_SIZE ? m_size - offset : size);
+  }
+
   /// @brief Get virtual address of mapped GPU buffer memory
   /// @details Writing or reading data at this address is directly reflected in
-  /// GPU memory.
+  /// GPU memory. Persistently mapped buffers return the cached address without
+  /// calling the driver.
   /// @param context GPU context reference
   /// @return Virtual GPU buffer memory address
   void* mapMemory(const Context& context) const;
 
   /// @brief Close GPU memory buffer connection
+  /// @details No-op for persistently mapped buffers.
   /// @param context GPU context reference
   void unmapMemory(const Context& context) const;
 };
@@ -8,13 +8,21 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
 #include <vulkan/vulkan.hpp>
 
 #include "../module_connection/gpu_ui.hpp"
+#include "allocator.hpp"
 #include "config.hpp"
+#include "deletion_queue.hpp"
+#include "descriptor_allocator.hpp"
 #include "device.hpp"
+#include "layout_cache.hpp"
+#include "memory_stats.hpp"
+#include "pipeline_cache_store.hpp"
 #include "swapchain.hpp"
+#include "view_cache.hpp"
 
 #ifdef GPU_DEBUG
   #include "debug.hpp"
@@ -33,6 +41,14 @@ class Context {
 #endif
   std::shared_ptr<gpu_ui::WindowSurface> m_ptrWindowSurface;
   std::unique_ptr<Device> m_ptrDevice;
+  std::unique_ptr<MemoryAllocator> m_ptrAllocator;
+  std::unique_ptr<DeletionQueue> m_ptrDeletionQueue;
+  std::unique_ptr<ResourceTracker> m_ptrResourceTracker;
+  std::unique_ptr<DescriptorAllocator> m_ptrDescriptorAllocator;
+  std::unique_ptr<LayoutCache> m_ptrLayoutCache;
+  std::unique_ptr<SamplerCache> m_ptrSamplerCache;
+  std::unique_ptr<ImageViewCache> m_ptrImageViewCache;
+  std::unique_ptr<PipelineCacheStore> m_ptrPipelineCacheStore;
   std::unique_ptr<Swapchain> m_ptrSwapchain;
 
   bool m_isInitialized = false;
@@ -40,7 +56,10 @@ class Context {
  public:
   /// @brief Construct Context with optional window surface
   /// @param window_surface Window surface for presentation (optional)
-  Context(std::shared_ptr<gpu_ui::WindowSurface> window_surface = nullptr);
+  /// @param pipeline_cache_path File the pipeline cache is loaded from and
+  /// saved to on destruction (optional; empty keeps it in memory only)
+  Context(std::shared_ptr<gpu_ui::WindowSurface> window_surface = nullptr,
+          std::filesystem::path pipeline_cache_path = {});
   ~Context();
 
   // Rule of Five
@@ -67,6 +86,73 @@ class Context {
     return m_ptrDevice;
   }
 
+  /// @brief Get device memory allocator pointer
+  /// @details Buffers and images created with this context sub-allocate their
+  /// memory from this allocator.
+  /// @return Unique pointer to memory allocator
+  const auto& getPtrAllocator() const {
+    return m_ptrAllocator;
+  }
+
+  /// @brief Get deferred destruction queue pointer
+  /// @details Hand resources the GPU may still read to this queue instead of
+  /// calling waitIdle() before destroying them.
+  /// @return Unique pointer to deletion queue
+  const auto& getPtrDeletionQueue() const {
+    return m_ptrDeletionQueue;
+  }
+
+  /// @brief Get persistent descriptor allocator pointer
+  /// @details DescriptorSet allocates from this allocator unless another one
+  /// is given.
+  /// @return Unique pointer to descriptor allocator
+  const auto& getPtrDescriptorAllocator() const {
+    return m_ptrDescriptorAllocator;
+  }
+
+  /// @brief Get descriptor set and pipeline layout cache pointer
+  /// @details DescriptorSetLayout and Pipeline take their layouts from this
+  /// cache, so identical layouts are created once per context.
+  /// @return Unique pointer to layout cache
+  const auto& getPtrLayoutCache() const {
+    return m_ptrLayoutCache;
+  }
+
+  /// @brief Get sampler cache pointer
+  /// @details Sampler objects with identical configuration share one handle.
+  /// @return Unique pointer to sampler cache
+  const auto& getPtrSamplerCache() const {
+    return m_ptrSamplerCache;
+  }
+
+  /// @brief Get image view cache pointer
+  /// @details ImageView objects of the same image and range share one handle.
+  /// @return Unique pointer to image view cache
+  const auto& getPtrImageViewCache() const {
+    return m_ptrImageViewCache;
+  }
+
+  /// @brief Get pipeline cache pointer
+  /// @details Every Pipeline is created through this cache. Call
+  /// PipelineCacheStore::save() to persist it before shutdown as well.
+  /// @return Unique pointer to pipeline cache store
+  const auto& getPtrPipelineCacheStore() const {
+    return m_ptrPipelineCacheStore;
+  }
+
+  /// @brief Get live resource tracker pointer
+  /// @return Unique pointer to resource tracker
+  const auto& getPtrResourceTracker() const {
+    return m_ptrResourceTracker;
+  }
+
+  /// @brief Take a snapshot of memory usage and live resources
+  /// @details Per-heap budgets are filled in only when VK_EXT_memory_budget
+  /// is supported. Frame counts cover the frame before the last
+  /// MemoryAllocator::markFrame() call.
+  /// @return Memory statistics (empty if the context is not initialized)
+  MemoryStats memoryStats() const;
+
   /// @brief Get swapchain pointer
   /// @return Unique pointer to swapchain
   const auto& getPtrSwapchain() const {
@@ -0,0 +1,109 @@
+/*
+ * deletion_queue.hpp - Deferred resource destruction for Pandolabo Vulkan C++
+ * wrapper
+ *
+ * This header contains the DeletionQueue class which keeps GPU resources
+ * alive until the timeline value or fence they depend on has been reached.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Device;
+class Fence;
+class TimelineSemaphore;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Deferred destruction queue for resources the GPU may still read
+/// @details push() takes ownership of a resource (gpu::Buffer, gpu::Image,
+/// gpu::DescriptorSet, Pipeline, or any vk::Unique* handle) together with the
+/// point of GPU progress it depends on. collect() destroys every resource whose
+/// point has passed, so resources can be replaced mid-run without waitIdle().
+/// The queue is owned by Context; whatever remains is destroyed after the
+/// device has gone idle in Context's destructor.
+class DeletionQueue {
+ private:
+  struct Entry {
+    vk::Semaphore semaphore;  ///< Timeline semaphore (null for fence entries)
+    uint64_t value = 0u;      ///< Timeline value to reach
+    vk::Fence fence;          ///< Fence to be signaled (null for timeline)
+    std::shared_ptr<void> ptr_resource;  ///< Type-erased owned resource
+  };
+
+  vk::Device m_device;
+  std::vector<Entry> m_entries;
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct queue for a device
+  /// @param device GPU device used to query semaphores and fences
+  explicit DeletionQueue(const Device& device);
+  ~DeletionQueue();
+
+  // Rule of Five
+  DeletionQueue(const DeletionQueue&) = delete;
+  DeletionQueue& operator=(const DeletionQueue&) = delete;
+  DeletionQueue(DeletionQueue&&) = delete;
+  DeletionQueue& operator=(DeletionQueue&&) = delete;
+
+  /// @brief Destroy a resource once a timeline semaphore reaches a value
+  /// @note Only the semaphore handle is stored: the semaphore must outlive
+  /// the entry, i.e. stay alive until collect() destroys the resource or the
+  /// queue is flushed.
+  /// @param resource Resource to take ownership of (moved in)
+  /// @param semaphore Timeline semaphore signaled by the last user
+  /// @param value Value signaled by the last submission using the resource
+  template <typename T>
+  void push(T resource, const TimelineSemaphore& semaphore, uint64_t value) {
+    enqueue(Entry{getSemaphoreHandle(semaphore),
+                  value,
+                  {},
+                  std::make_shared<T>(std::move(resource))});
+  }
+
+  /// @brief Destroy a resource once a fence is signaled
+  /// @details Suited to frame fences: the fence must be the one passed to the
+  /// last submission using the resource. A fence that is reset before
+  /// collect() observes it only delays destruction to its next signal.
+  /// @note Only the fence handle is stored: the fence must outlive the entry,
+  /// i.e. stay alive until collect() destroys the resource or the queue is
+  /// flushed.
+  /// @param resource Resource to take ownership of (moved in)
+  /// @param fence Fence signaled by the last submission using the resource
+  template <typename T>
+  void push(T resource, const Fence& fence) {
+    enqueue(Entry{{},
+                  0u,
+                  getFenceHandle(fence),
+                  std::make_shared<T>(std::move(resource))});
+  }
+
+  /// @brief Destroy every resource whose dependency has been reached
+  /// @return Number of resources destroyed
+  size_t collect();
+
+  /// @brief Destroy every resource regardless of its dependency
+  /// @note Only call when the device is idle
+  void flush();
+
+  /// @brief Get number of resources waiting for destruction
+  size_t getPendingCount() const;
+
+ private:
+  void enqueue(Entry&& entry);
+  bool isReached(const Entry& entry) const;
+
+  static vk::Semaphore getSemaphoreHandle(const TimelineSemaphore& semaphore);
+  static vk::Fence getFenceHandle(const Fence& fence);
+};
+
+}  // namespace pandora::core::gpu
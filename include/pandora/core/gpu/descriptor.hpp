@@ -10,11 +10,14 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
+#include "../error.hpp"
 #include "../structures.hpp"
 #include "../types.hpp"
+#include "descriptor_allocator.hpp"
 
 // Forward declarations
 namespace pandora::core::gpu {
@@ -32,6 +35,7 @@ class BufferDescription {
  private:
   struct BufferInfo {
     vk::Buffer buffer;
+    size_t offset;
     size_t size;
   } m_bufferInfo;
 
@@ -46,6 +50,19 @@ class BufferDescription {
   /// @param buffer Buffer object to bind to the descriptor
   BufferDescription(const DescriptorInfo& descriptor_info,
                     const Buffer& buffer);
+
+  /// @brief Construct buffer descriptor for a sub-range of a buffer
+  /// @details For dynamic uniform/storage descriptors the offset is the base
+  /// and the dynamic offset given at bind time is added on top of it.
+  /// @param descriptor_info Binding information (binding index, type, etc.)
+  /// @param buffer Buffer object to bind to the descriptor
+  /// @param offset Byte offset of the range (a multiple of
+  /// minUniformBufferOffsetAlignment)
+  /// @param range Byte size of the range
+  BufferDescription(const DescriptorInfo& descriptor_info,
+                    const Buffer& buffer,
+                    size_t offset,
+                    size_t range);
   ~BufferDescription();
 
   /// @brief Create buffer descriptor info
@@ -113,6 +130,12 @@ class ImageDescription {
       const vk::DescriptorImageInfo& info) const;
 };
 
+/// @brief How sets of a DescriptorSetLayout are supplied to shaders
+enum class DescriptorSetLayoutType {
+  Default = 0u,    ///< Allocated DescriptorSet objects
+  PushDescriptor,  ///< Written per draw by CommandBuffer::pushDescriptors()
+};
+
 /// @brief Descriptor set layout wrapper for managing shader resource bindings
 /// Encapsulates Vulkan descriptor set layout creation and management.
 /// Defines the types and bindings of resources (buffers, images, samplers)
@@ -125,17 +148,43 @@ class ImageDescription {
 /// resource bindings.
 class DescriptorSetLayout {
  private:
-  vk::UniqueDescriptorSetLayout
-      m_ptrDescriptorSetLayout{};  ///< Vulkan descriptor set layout
+  vk::DescriptorSetLayout
+      m_descriptorSetLayout{};  ///< Shared layout owned by LayoutCache
   std::vector<vk::DescriptorPoolSize>
       m_descriptorPoolSizes{};  ///< Pool sizes for descriptor allocation
+  uint32_t m_setIndex = 0u;  ///< layout(set = N) this layout describes
+  DescriptorSetLayoutType m_layoutType = DescriptorSetLayoutType::Default;
 
  public:
-  /// @brief Construct descriptor set layout from description unit
+  /// @brief Construct layout of set 0 from description unit
   /// @param context Vulkan context for device operations
   /// @param description_unit Description unit containing binding information
-  DescriptorSetLayout(const Context& context,
-                      const DescriptionUnit& description_unit);
+  /// @param layout_type PushDescriptor requires Device::hasPushDescriptor()
+  /// and no dynamic buffer bindings
+  /// @throws vk::FeatureNotPresentError if PushDescriptor is requested on a
+  /// device without VK_KHR_push_descriptor
+  DescriptorSetLayout(
+      const Context& context,
+      const DescriptionUnit& description_unit,
+      DescriptorSetLayoutType layout_type = DescriptorSetLayoutType::Default);
+
+  /// @brief Construct layout of one descriptor set from description unit
+  /// @details Only bindings declared with layout(set = set_index) are
+  /// included. Build one layout per entry of
+  /// DescriptionUnit::getSetIndices() and group bindings by update frequency
+  /// (per frame, per pass, per material, per object).
+  /// @param context Vulkan context for device operations
+  /// @param description_unit Description unit containing binding information
+  /// @param set_index Descriptor set index to build
+  /// @param layout_type PushDescriptor requires Device::hasPushDescriptor()
+  /// and no dynamic buffer bindings
+  /// @throws vk::FeatureNotPresentError if PushDescriptor is requested on a
+  /// device without VK_KHR_push_descriptor
+  DescriptorSetLayout(
+      const Context& context,
+      const DescriptionUnit& description_unit,
+      uint32_t set_index,
+      DescriptorSetLayoutType layout_type = DescriptorSetLayoutType::Default);
 
   // Rule of Five
   ~DescriptorSetLayout();
@@ -147,7 +196,23 @@ class DescriptorSetLayout {
   /// @brief Get Vulkan descriptor set layout handle
   /// @return Reference to Vulkan descriptor set layout
   const auto& getDescriptorSetLayout() const {
-    return m_ptrDescriptorSetLayout.get();
+    return m_descriptorSetLayout;
+  }
+
+  /// @brief Get descriptor set index this layout describes
+  uint32_t getSetIndex() const {
+    return m_setIndex;
+  }
+
+  /// @brief Get how sets of this layout are supplied
+  DescriptorSetLayoutType getLayoutType() const {
+    return m_layoutType;
+  }
+
+  /// @brief Get descriptors needed by one set of this layout
+  /// @return One pool size entry per binding
+  const auto& getDescriptorPoolSizes() const {
+    return m_descriptorPoolSizes;
   }
 
   /// @brief Get descriptor pool creation info for this layout
@@ -155,38 +220,126 @@ class DescriptorSetLayout {
   vk::DescriptorPoolCreateInfo getDescriptorPoolInfo() const;
 };
 
+/// @brief One packed descriptor write consumed by DescriptorUpdateTemplate
+/// @details Slots are laid out contiguously; keep an array of these (one per
+/// template slot) and rewrite it in place to update a set without any
+/// allocation.
+union DescriptorData {
+  vk::DescriptorBufferInfo buffer_info{};
+  vk::DescriptorImageInfo image_info;
+
+  /// @brief Build buffer data for uniform and storage buffer bindings
+  /// @param buffer Buffer to bind
+  /// @param offset Byte offset of the range
+  /// @param range Byte size of the range (VK_WHOLE_SIZE for the rest)
+  static DescriptorData fromBuffer(const Buffer& buffer,
+                                   vk::DeviceSize offset = 0u,
+                                   vk::DeviceSize range = VK_WHOLE_SIZE);
+
+  /// @brief Build image data for storage or sampled image bindings
+  /// @param image_view Image view to bind
+  /// @param image_layout Layout the image is in when accessed
+  static DescriptorData fromImage(const ImageView& image_view,
+                                  ImageLayout image_layout);
+
+  /// @brief Build image data for combined image sampler bindings
+  /// @param image_view Image view to sample
+  /// @param image_layout Layout the image is in when sampled
+  /// @param sampler Sampler used with the view
+  static DescriptorData fromImage(const ImageView& image_view,
+                                  ImageLayout image_layout,
+                                  const Sampler& sampler);
+};
+
+/// @brief Descriptor update template built from shader reflection
+/// Describes every binding of the layout's set once, so a set is rewritten by
+/// a single vkUpdateDescriptorSetWithTemplate call reading a caller-owned
+/// DescriptorData array instead of building write structures per update.
+/// Slots follow ascending binding order; use getSlot() to locate a binding.
+class DescriptorUpdateTemplate {
+ private:
+  vk::UniqueDescriptorUpdateTemplate m_ptrUpdateTemplate{};
+  std::vector<uint32_t> m_slotBindings{};  ///< Binding number of each slot
+
+ public:
+  /// @brief Construct update template for sets of a layout
+  /// @param context Vulkan context for device operations
+  /// @param description_unit Description unit the layout was built from
+  /// @param descriptor_set_layout Layout of the sets to update
+  DescriptorUpdateTemplate(const Context& context,
+                           const DescriptionUnit& description_unit,
+                           const DescriptorSetLayout& descriptor_set_layout);
+
+  // Rule of Five
+  ~DescriptorUpdateTemplate();
+  DescriptorUpdateTemplate(const DescriptorUpdateTemplate&) = delete;
+  DescriptorUpdateTemplate& operator=(const DescriptorUpdateTemplate&) =
+      delete;
+  DescriptorUpdateTemplate(DescriptorUpdateTemplate&&) = default;
+  DescriptorUpdateTemplate& operator=(DescriptorUpdateTemplate&&) = default;
+
+  /// @brief Get Vulkan descriptor update template handle
+  const auto& getUpdateTemplate() const {
+    return m_ptrUpdateTemplate.get();
+  }
+
+  /// @brief Get number of DescriptorData slots an update reads
+  size_t getSlotCount() const {
+    return m_slotBindings.size();
+  }
+
+  /// @brief Get slot index of a binding
+  /// @param binding Binding number in the shader
+  /// @return Index into the DescriptorData array
+  Result<size_t> getSlot(uint32_t binding) const;
+};
+
 /// @brief Descriptor set wrapper for binding resources to shaders
 /// Manages allocation and updating of descriptor sets from descriptor pools.
 /// Provides interface for binding buffers, images, and samplers to shader
 /// stages. Represents actual resource bindings that follow the structure
 /// defined by DescriptorSetLayout.
 ///
-/// This class handles GPU memory allocation for shader binding data and
-/// provides methods to update resource bindings efficiently without recreating
-/// the entire set.
+/// Sets are carved from a DescriptorAllocator instead of owning a pool each.
+/// By default the context's persistent allocator is used and the set is
+/// returned to it on destruction; sets from a transient allocator are simply
+/// dropped and recycled by DescriptorAllocator::reset().
 class DescriptorSet {
  private:
-  vk::UniqueDescriptorPool m_ptrDescriptorPool{};  ///< Vulkan descriptor pool
-  vk::UniqueDescriptorSet m_ptrDescriptorSet{};    ///< Vulkan descriptor set
+  DescriptorAllocator* m_ptrAllocator = nullptr;  ///< Set only when freeable
+  DescriptorAllocator::Allocation m_allocation{};  ///< Pool and set handles
+  uint32_t m_setIndex = 0u;  ///< Set index the layout was built for
 
  public:
-  /// @brief Construct descriptor set from layout
+  /// @brief Construct descriptor set from the context's descriptor allocator
   /// @param context Vulkan context for device operations
   /// @param description_set_layout Layout template defining resource structure
   DescriptorSet(const Context& context,
                 const DescriptorSetLayout& description_set_layout);
 
+  /// @brief Construct descriptor set from a specific descriptor allocator
+  /// @param description_set_layout Layout template defining resource structure
+  /// @param descriptor_allocator Allocator that must outlive this set
+  DescriptorSet(const DescriptorSetLayout& description_set_layout,
+                DescriptorAllocator& descriptor_allocator);
+
   // Rule of Five
   ~DescriptorSet();
   DescriptorSet(const DescriptorSet&) = delete;
   DescriptorSet& operator=(const DescriptorSet&) = delete;
-  DescriptorSet(DescriptorSet&&) = default;
-  DescriptorSet& operator=(DescriptorSet&&) = default;
+  DescriptorSet(DescriptorSet&& other) noexcept;
+  DescriptorSet& operator=(DescriptorSet&& other) noexcept;
 
   /// @brief Get Vulkan descriptor set handle
   /// @return Reference to Vulkan descriptor set
   const auto& getDescriptorSet() const {
-    return m_ptrDescriptorSet.get();
+    return m_allocation.descriptor_set;
+  }
+
+  /// @brief Get descriptor set index this set is bound at
+  /// @return Set index of the layout it was allocated with
+  uint32_t getSetIndex() const {
+    return m_setIndex;
   }
 
   /// @brief Update descriptor set with resource bindings
@@ -202,10 +355,21 @@ class DescriptorSet {
       const std::vector<BufferDescription>& buffer_descriptions,
       const std::vector<ImageDescription>& image_descriptions);
 
-  /// @brief Free GPU memory for descriptor set to prepare for next update
-  /// Useful for changing image resource data without changing shader modules
-  /// or description units. Provides efficient memory management by allowing
-  /// reuse of descriptor sets with different resource bindings.
+  /// @brief Update descriptor set through an update template
+  /// One driver call reading the packed data; nothing is allocated.
+  /// @param context Vulkan context for device operations
+  /// @param update_template Template created for this set's layout
+  /// @param descriptor_data One entry per template slot
+  /// @return Validation error if descriptor_data has fewer entries than the
+  /// template has slots; the set is left unchanged
+  [[nodiscard]] VoidResult updateDescriptorSet(
+      const Context& context,
+      const DescriptorUpdateTemplate& update_template,
+      std::span<const DescriptorData> descriptor_data);
+
+  /// @brief Return the set to its allocator before destruction
+  /// Useful for releasing descriptor memory early without destroying the
+  /// wrapper. The set handle is cleared and must not be bound afterwards.
   /// @param context Vulkan context for device operations
   void freeDescriptorSet(const Context& context);
 };
@@ -0,0 +1,128 @@
+/*
+ * descriptor_allocator.hpp - Pooled descriptor set allocation for Pandolabo
+ * Vulkan C++ wrapper
+ *
+ * This header contains the DescriptorAllocator class which carves descriptor
+ * sets out of a growing list of large descriptor pools.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "memory_stats.hpp"
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Context;
+class DescriptorSetLayout;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Lifetime model of the sets handed out by DescriptorAllocator
+enum class DescriptorAllocatorMode {
+  Persistent = 0u,  ///< Sets are returned one by one when DescriptorSet dies
+  Transient,        ///< Sets live until reset(), e.g. once per frame
+};
+
+/// @brief Descriptor set allocator backed by a growable list of pools
+/// @details Sets are allocated from the current pool; when it reports
+/// OUT_OF_POOL_MEMORY (or fragmentation) the allocator moves on to the next
+/// pool with room, creating a larger one if none is left. Pool sizes are
+/// derived from per-type ratios times the pool's set count, so a pool serves
+/// many different layouts.
+///
+/// Context owns a Persistent allocator used by DescriptorSet by default.
+/// Create one Transient allocator per frame in flight for per-frame sets and
+/// call reset() once the frame's fence has been waited on: every pool is
+/// recycled with one vkResetDescriptorPool call and no pool is recreated.
+class DescriptorAllocator {
+ public:
+  /// @brief Descriptors of one type reserved per set in each pool
+  struct PoolSizeRatio {
+    vk::DescriptorType type{};
+    float ratio = 1.0f;
+  };
+
+  /// @brief Set handed out by allocate()
+  struct Allocation {
+    vk::DescriptorPool pool{};
+    vk::DescriptorSet descriptor_set{};
+  };
+
+ private:
+  struct Pool {
+    vk::UniqueDescriptorPool ptr_pool;
+    uint32_t live_set_count = 0u;
+    bool is_full = false;
+    TrackedResourceToken tracking_token;
+  };
+
+  static constexpr uint32_t MAX_SETS_PER_POOL = 4096u;
+
+  vk::Device m_device;
+  ResourceTracker* m_ptrTracker = nullptr;
+  DescriptorAllocatorMode m_mode = DescriptorAllocatorMode::Persistent;
+  std::vector<PoolSizeRatio> m_poolSizeRatios;
+  uint32_t m_nextSetsPerPool = 0u;
+
+  std::vector<std::unique_ptr<Pool>> m_pools;
+  std::vector<Pool*> m_readyPools;  ///< Pools with room; back() is current
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct allocator without creating any pool yet
+  /// @param context GPU context
+  /// @param mode Whether sets are freed individually or reset together
+  /// @param initial_sets_per_pool Sets in the first pool; each new pool doubles
+  /// it up to 4096
+  /// @param pool_size_ratios Descriptors per set for each descriptor type
+  DescriptorAllocator(
+      const Context& context,
+      DescriptorAllocatorMode mode = DescriptorAllocatorMode::Persistent,
+      uint32_t initial_sets_per_pool = 64u,
+      std::vector<PoolSizeRatio> pool_size_ratios = getDefaultPoolSizeRatios());
+  ~DescriptorAllocator();
+
+  // Rule of Five
+  DescriptorAllocator(const DescriptorAllocator&) = delete;
+  DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+  DescriptorAllocator(DescriptorAllocator&&) = delete;
+  DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+
+  /// @brief Allocate one descriptor set
+  /// @param descriptor_set_layout Layout of the set
+  /// @return Set and the pool it came from
+  /// @throws vk::OutOfPoolMemoryError if even a fresh pool cannot hold it
+  Allocation allocate(const DescriptorSetLayout& descriptor_set_layout);
+
+  /// @brief Return a set to its pool (Persistent mode only)
+  /// @param allocation Set returned by allocate()
+  void free(const Allocation& allocation);
+
+  /// @brief Recycle every pool at once (Transient mode only)
+  /// @note All sets allocated so far become invalid; only call once the GPU
+  /// no longer reads them.
+  void reset();
+
+  /// @brief Get lifetime model of the sets
+  DescriptorAllocatorMode getMode() const {
+    return m_mode;
+  }
+
+  /// @brief Get number of descriptor pools created so far
+  size_t getPoolCount() const;
+
+  /// @brief Get ratios suited to typical material and compute layouts
+  static std::vector<PoolSizeRatio> getDefaultPoolSizeRatios();
+
+ private:
+  Pool& createPool(const DescriptorSetLayout& descriptor_set_layout);
+};
+
+}  // namespace pandora::core::gpu
@@ -31,7 +31,12 @@ class Device {
  private:
   vk::PhysicalDevice m_physicalDevice;
   vk::UniqueDevice m_ptrLogicalDevice;
+  vk::PhysicalDeviceProperties m_properties{};
+  vk::PhysicalDeviceMemoryProperties m_memoryProperties{};
   bool m_hasWindowSurface;
+  bool m_hasMemoryBudget = false;
+  bool m_hasDescriptorIndexing = false;
+  bool m_hasPushDescriptor = false;
 
   struct QueueFamilyIndices {
     std::optional<uint32_t> graphics;
@@ -72,6 +77,45 @@ class Device {
     return m_ptrLogicalDevice;
   }
 
+  /// @brief Get physical device properties queried at construction
+  /// @return Reference to cached physical device properties
+  const auto& getProperties() const {
+    return m_properties;
+  }
+
+  /// @brief Get physical device limits queried at construction
+  /// @return Reference to cached physical device limits
+  const auto& getLimits() const {
+    return m_properties.limits;
+  }
+
+  /// @brief Get memory heaps and types queried at construction
+  /// @return Reference to cached memory properties
+  const auto& getMemoryProperties() const {
+    return m_memoryProperties;
+  }
+
+  /// @brief Check whether VK_EXT_memory_budget is enabled
+  /// @return True if heap budgets can be queried
+  bool hasMemoryBudget() const {
+    return m_hasMemoryBudget;
+  }
+
+  /// @brief Check whether Vulkan 1.2 descriptor indexing is enabled
+  /// @details Covers runtime arrays, partially bound and update-after-bind
+  /// bindings, and non-uniform indexing of every array kind required by
+  /// BindlessHeap.
+  /// @return True if bindless descriptors can be used
+  bool hasDescriptorIndexing() const {
+    return m_hasDescriptorIndexing;
+  }
+
+  /// @brief Check whether VK_KHR_push_descriptor is enabled
+  /// @return True if push-descriptor layouts can be created
+  bool hasPushDescriptor() const {
+    return m_hasPushDescriptor;
+  }
+
   /// @brief Search queue family index from queue family type
   /// @details Queue in the header file means command queue for GPU calculation.
   /// Queue family is a group of queues. Each queue family has different
@@ -8,16 +8,20 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
 #include "../module_connection/gpu_ui.hpp"
 #include "../structures.hpp"
 #include "../types.hpp"
+#include "allocator.hpp"
+#include "memory_stats.hpp"
 
 // Forward declarations
 namespace pandora::core::gpu {
 class Context;
+class ImageViewCache;
 }
 
 namespace pandora::core::gpu {
@@ -27,8 +31,10 @@ namespace pandora::core::gpu {
 /// render targets, etc.
 class Image {
  protected:
-  vk::UniqueDeviceMemory m_ptrMemory;
+  MemoryAllocation m_memoryAllocation;
   vk::UniqueImage m_ptrImage;
+  TrackedResourceToken m_trackingToken;
+  ImageViewCache* m_ptrViewCache = nullptr;  ///< Purged on destruction
 
   uint32_t m_mipLevels = 0u;
   uint32_t m_arrayLayers = 0u;
@@ -45,18 +51,22 @@ class Image {
   /// @param transfer_type Transfer operation type
   /// @param image_usages Image usage types
   /// @param image_sub_info Image sub-resource information
+  /// @param allocation_strategy Pooled (default) or dedicated device memory
   Image(const Context& context,
         MemoryUsage memory_usage,
         TransferType transfer_type,
         const std::vector<ImageUsage>& image_usages,
-        const ImageSubInfo& image_sub_info);
+        const ImageSubInfo& image_sub_info,
+        AllocationStrategy allocation_strategy = AllocationStrategy::Pooled);
   ~Image();
 
   /// @brief Move constructor
   /// @param other Image to move from
   Image(Image&& other) noexcept {
-    m_ptrMemory = std::move(other.m_ptrMemory);
     m_ptrImage = std::move(other.m_ptrImage);
+    m_memoryAllocation = std::move(other.m_memoryAllocation);
+    m_trackingToken = std::move(other.m_trackingToken);
+    m_ptrViewCache = std::exchange(other.m_ptrViewCache, nullptr);
     m_mipLevels = other.m_mipLevels;
     m_arrayLayers = other.m_arrayLayers;
     m_format = other.m_format;
@@ -68,8 +78,14 @@ class Image {
   /// @param other Image to move from
   /// @return Reference to this image
   Image& operator=(Image&& other) noexcept {
-    m_ptrMemory = std::move(other.m_ptrMemory);
+    if (this == &other) {
+      return *this;
+    }
+    purgeCachedViews();
     m_ptrImage = std::move(other.m_ptrImage);
+    m_memoryAllocation = std::move(other.m_memoryAllocation);
+    m_trackingToken = std::move(other.m_trackingToken);
+    m_ptrViewCache = std::exchange(other.m_ptrViewCache, nullptr);
     m_mipLevels = other.m_mipLevels;
     m_arrayLayers = other.m_arrayLayers;
     m_format = other.m_format;
@@ -90,6 +106,12 @@ class Image {
     return m_ptrImage.get();
   }
 
+  /// @brief Get device memory allocation backing this image
+  /// @return Reference to memory allocation
+  const auto& getMemoryAllocation() const {
+    return m_memoryAllocation;
+  }
+
   /// @brief Get mip levels count
   /// @return Number of mip levels
   auto getMipLevels() const {
@@ -119,15 +141,20 @@ class Image {
   const auto& getGraphicalSize() const {
     return m_graphicalSize;
   }
+
+ private:
+  void purgeCachedViews() noexcept;
 };
 
 /// @brief Vulkan image view wrapper class
 /// @details Image view is separated from image resource because image resource
 /// is only memory data and the way to handle image is decided by image view.
+/// Views of the same image and range share one handle through the context's
+/// ImageViewCache. Copies share that handle too, so ImageView is cheap to copy.
 class ImageView {
  private:
-  vk::UniqueImageView m_ptrImageView;
-  std::unique_ptr<ImageViewInfo> m_ptrImageViewInfo;
+  std::shared_ptr<vk::UniqueImageView> m_ptrImageView;
+  ImageViewInfo m_imageViewInfo;
 
  public:
   /// @brief Construct image view for the given image
@@ -139,25 +166,33 @@ class ImageView {
             const ImageViewInfo& image_view_info);
   ~ImageView();
 
+  // Rule of Five
+  ImageView(const ImageView&) = default;
+  ImageView& operator=(const ImageView&) = default;
+  ImageView(ImageView&&) noexcept = default;
+  ImageView& operator=(ImageView&&) noexcept = default;
+
   /// @brief Get image view handle
   /// @return Vulkan image view handle
   const auto& getImageView() const {
-    return m_ptrImageView.get();
+    return m_ptrImageView->get();
   }
 
   /// @brief Get image view information
   /// @return Image view configuration
   const auto& getImageViewInfo() const {
-    return *m_ptrImageViewInfo;
+    return m_imageViewInfo;
   }
 };
 
 /// @brief Vulkan sampler wrapper class
 /// @details Sampler is used for texture filtering, mipmapping, and texture
-/// interface on shader.
+/// interface on shader. Samplers with the same configuration share one handle
+/// through the context's SamplerCache. Copies share that handle too, so Sampler
+/// is cheap to copy.
 class Sampler {
  private:
-  vk::UniqueSampler m_ptrSampler;
+  std::shared_ptr<vk::UniqueSampler> m_ptrSampler;
 
  public:
   /// @brief Construct sampler with specified configuration
@@ -166,10 +201,16 @@ class Sampler {
   Sampler(const Context& context, const SamplerInfo& sampler_info);
   ~Sampler();
 
+  // Rule of Five
+  Sampler(const Sampler&) = default;
+  Sampler& operator=(const Sampler&) = default;
+  Sampler(Sampler&&) noexcept = default;
+  Sampler& operator=(Sampler&&) noexcept = default;
+
   /// @brief Get sampler handle
   /// @return Vulkan sampler handle
   const auto& getSampler() const {
-    return m_ptrSampler.get();
+    return m_ptrSampler->get();
   }
 };
 
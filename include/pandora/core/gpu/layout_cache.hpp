@@ -0,0 +1,89 @@
+/*
+ * layout_cache.hpp - Deduplicating layout cache for Pandolabo Vulkan C++
+ * wrapper
+ *
+ * This header contains the LayoutCache class which shares descriptor set
+ * layouts and pipeline layouts with identical contents.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Device;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Context-wide cache of descriptor set layouts and pipeline layouts
+/// @details Layouts are looked up by a structural hash of their contents
+/// (bindings and flags, or set layouts and push constant ranges) and created
+/// only on a miss. Binding and range order does not matter. Identical shaders
+/// therefore share one handle, and pipelines built from them have compatible
+/// layouts, so bound descriptor sets survive pipeline switches.
+///
+/// Handles are owned by the cache and stay valid until the Context is
+/// destroyed. Immutable samplers are not part of the key and must not be
+/// used.
+class LayoutCache {
+ private:
+  struct DescriptorSetLayoutEntry {
+    vk::DescriptorSetLayoutCreateFlags flags{};
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    vk::UniqueDescriptorSetLayout ptr_layout;
+  };
+
+  struct PipelineLayoutEntry {
+    std::vector<vk::DescriptorSetLayout> set_layouts;
+    std::vector<vk::PushConstantRange> push_constant_ranges;
+    vk::UniquePipelineLayout ptr_layout;
+  };
+
+  vk::Device m_device;
+  std::unordered_multimap<uint64_t, DescriptorSetLayoutEntry>
+      m_descriptorSetLayouts;
+  std::unordered_multimap<uint64_t, PipelineLayoutEntry> m_pipelineLayouts;
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct empty cache
+  /// @param device Device the layouts are created on
+  explicit LayoutCache(const Device& device);
+  ~LayoutCache();
+
+  // Rule of Five
+  LayoutCache(const LayoutCache&) = delete;
+  LayoutCache& operator=(const LayoutCache&) = delete;
+  LayoutCache(LayoutCache&&) = delete;
+  LayoutCache& operator=(LayoutCache&&) = delete;
+
+  /// @brief Get descriptor set layout with the given contents
+  /// @param bindings Bindings of the set, in any order
+  /// @param flags Layout create flags (e.g. push descriptor)
+  /// @return Shared layout handle owned by the cache
+  vk::DescriptorSetLayout getDescriptorSetLayout(
+      std::vector<vk::DescriptorSetLayoutBinding> bindings,
+      vk::DescriptorSetLayoutCreateFlags flags = {});
+
+  /// @brief Get pipeline layout with the given contents
+  /// @param set_layouts Set layouts, indexed by set number
+  /// @param push_constant_ranges Push constant ranges, in any order
+  /// @return Shared layout handle owned by the cache
+  vk::PipelineLayout getPipelineLayout(
+      const std::vector<vk::DescriptorSetLayout>& set_layouts,
+      std::vector<vk::PushConstantRange> push_constant_ranges);
+
+  /// @brief Get number of distinct descriptor set layouts created
+  size_t getDescriptorSetLayoutCount() const;
+
+  /// @brief Get number of distinct pipeline layouts created
+  size_t getPipelineLayoutCount() const;
+};
+
+}  // namespace pandora::core::gpu
@@ -0,0 +1,146 @@
+/*
+ * memory_stats.hpp - Memory and resource statistics for Pandolabo Vulkan C++
+ * wrapper
+ *
+ * This header contains the MemoryStats snapshot returned by
+ * Context::memoryStats() and the ResourceTracker that counts live GPU
+ * resources per context.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace pandora::core::gpu {
+
+/// @brief Resource kinds counted by ResourceTracker
+enum class TrackedResource {
+  Buffer = 0u,
+  Image,
+  DescriptorPool,
+  Pipeline,
+};
+
+/// @brief Memory usage of one memory heap
+struct HeapStats {
+  uint32_t heap_index = 0u;
+  vk::DeviceSize heap_size = 0u;      ///< Size reported by the driver
+  bool is_device_local = false;       ///< Heap has DEVICE_LOCAL flag
+  vk::DeviceSize allocated_bytes = 0u;  ///< Device memory held by allocator
+  vk::DeviceSize used_bytes = 0u;  ///< Bytes handed out to live resources
+  std::optional<vk::DeviceSize> budget_bytes;  ///< VK_EXT_memory_budget only
+  std::optional<vk::DeviceSize> process_usage_bytes;  ///< Driver-side usage
+};
+
+/// @brief Live resource counts
+struct ResourceCounts {
+  uint64_t buffers = 0u;
+  uint64_t images = 0u;
+  uint64_t descriptor_pools = 0u;
+  uint64_t pipelines = 0u;
+};
+
+/// @brief Snapshot returned by Context::memoryStats()
+struct MemoryStats {
+  std::vector<HeapStats> heaps;
+  ResourceCounts live_resources;
+  size_t device_memory_count = 0u;  ///< vkAllocateMemory objects held
+  uint64_t total_allocation_count = 0u;
+  uint64_t total_free_count = 0u;
+  uint64_t frame_allocation_count = 0u;  ///< During the last marked frame
+  uint64_t frame_free_count = 0u;        ///< During the last marked frame
+  bool has_memory_budget = false;
+
+  /// @brief Serialize the snapshot
+  /// @param indent Spaces per indentation level (-1 for a single line)
+  /// @return JSON text
+  std::string toJson(int32_t indent = 2) const;
+};
+
+/// @brief Counts live resources created with one context
+/// @details Owned by Context. Resources hold a TrackedResourceToken, so the
+/// tracker must outlive every resource created with the context.
+class ResourceTracker {
+ private:
+  std::array<std::atomic<uint64_t>, 4u> m_liveCounts{};
+
+ public:
+  ResourceTracker() = default;
+  ~ResourceTracker() = default;
+
+  // Rule of Five
+  ResourceTracker(const ResourceTracker&) = delete;
+  ResourceTracker& operator=(const ResourceTracker&) = delete;
+  ResourceTracker(ResourceTracker&&) = delete;
+  ResourceTracker& operator=(ResourceTracker&&) = delete;
+
+  void add(TrackedResource kind) {
+    m_liveCounts.at(static_cast<size_t>(kind)).fetch_add(1u);
+  }
+
+  void remove(TrackedResource kind) {
+    m_liveCounts.at(static_cast<size_t>(kind)).fetch_sub(1u);
+  }
+
+  /// @brief Get number of live resources of a kind
+  uint64_t getLiveCount(TrackedResource kind) const {
+    return m_liveCounts.at(static_cast<size_t>(kind)).load();
+  }
+
+  /// @brief Get live counts of every kind
+  ResourceCounts getLiveCounts() const {
+    return ResourceCounts{getLiveCount(TrackedResource::Buffer),
+                          getLiveCount(TrackedResource::Image),
+                          getLiveCount(TrackedResource::DescriptorPool),
+                          getLiveCount(TrackedResource::Pipeline)};
+  }
+};
+
+/// @brief Keeps one resource counted in a ResourceTracker while alive
+/// @details Move-only; the count moves with the token, so moved-from
+/// resources are not counted twice.
+class TrackedResourceToken {
+ private:
+  ResourceTracker* m_ptrTracker = nullptr;
+  TrackedResource m_kind = TrackedResource::Buffer;
+
+ public:
+  TrackedResourceToken() = default;
+  TrackedResourceToken(ResourceTracker* tracker, TrackedResource kind)
+      : m_ptrTracker(tracker), m_kind(kind) {
+    if (m_ptrTracker) {
+      m_ptrTracker->add(m_kind);
+    }
+  }
+  ~TrackedResourceToken() {
+    if (m_ptrTracker) {
+      m_ptrTracker->remove(m_kind);
+    }
+  }
+
+  // Rule of Five
+  TrackedResourceToken(const TrackedResourceToken&) = delete;
+  TrackedResourceToken& operator=(const TrackedResourceToken&) = delete;
+  TrackedResourceToken(TrackedResourceToken&& other) noexcept
+      : m_ptrTracker(std::exchange(other.m_ptrTracker, nullptr)),
+        m_kind(other.m_kind) {}
+  TrackedResourceToken& operator=(TrackedResourceToken&& other) noexcept {
+    if (this != &other) {
+      if (m_ptrTracker) {
+        m_ptrTracker->remove(m_kind);
+      }
+      m_ptrTracker = std::exchange(other.m_ptrTracker, nullptr);
+      m_kind = other.m_kind;
+    }
+    return *this;
+  }
+};
+
+}  // namespace pandora::core::gpu
@@ -0,0 +1,79 @@
+/*
+ * pipeline_cache_store.hpp - Persistent pipeline cache for Pandolabo Vulkan
+ * C++ wrapper
+ *
+ * This header contains the PipelineCacheStore class which keeps a
+ * VkPipelineCache alive for the whole context and persists it to disk.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vulkan/vulkan.hpp>
+
+#include "../error.hpp"
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Device;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief VkPipelineCache shared by every pipeline of a context
+/// @details The cache is seeded from a file at construction and written back
+/// with save(). The file starts with a small header (magic, version, vendor
+/// and device IDs, driver version, pipelineCacheUUID, payload size and
+/// checksum). A file written by another GPU or driver, or a truncated or
+/// corrupt one, is ignored and the cache starts empty, so stale data is never
+/// handed to the driver.
+class PipelineCacheStore {
+ private:
+  vk::Device m_device;
+  vk::PhysicalDeviceProperties m_deviceProperties{};
+  vk::UniquePipelineCache m_ptrPipelineCache;
+  std::filesystem::path m_filePath;
+  bool m_isLoadedFromFile = false;
+
+ public:
+  /// @brief Construct cache, seeding it from file_path if it is valid
+  /// @param device Device the pipelines are created on
+  /// @param file_path Cache file; empty keeps the cache in memory only
+  PipelineCacheStore(const Device& device, std::filesystem::path file_path);
+  ~PipelineCacheStore();
+
+  // Rule of Five
+  PipelineCacheStore(const PipelineCacheStore&) = delete;
+  PipelineCacheStore& operator=(const PipelineCacheStore&) = delete;
+  PipelineCacheStore(PipelineCacheStore&&) = delete;
+  PipelineCacheStore& operator=(PipelineCacheStore&&) = delete;
+
+  /// @brief Get pipeline cache handle passed to pipeline creation
+  const auto& getPipelineCache() const {
+    return m_ptrPipelineCache.get();
+  }
+
+  /// @brief Get file the cache is loaded from and saved to
+  const auto& getFilePath() const {
+    return m_filePath;
+  }
+
+  /// @brief Check whether construction found a valid cache file
+  bool isLoadedFromFile() const {
+    return m_isLoadedFromFile;
+  }
+
+  /// @brief Write the cache to its file
+  /// @details The file is replaced atomically through a temporary file. Does
+  /// nothing if the store has no file path.
+  /// @return Error if the file cannot be written
+  VoidResult save() const;
+
+  /// @brief Write the cache to another file
+  /// @param file_path Destination file
+  /// @return Error if the file cannot be written
+  VoidResult save(const std::filesystem::path& file_path) const;
+};
+
+}  // namespace pandora::core::gpu
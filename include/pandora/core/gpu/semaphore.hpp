@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <vulkan/vulkan.hpp>
 
@@ -63,6 +64,20 @@ class TimelineSemaphore {
   const auto& getSemaphore() const {
     return m_ptrSemaphore.get();
   }
+
+  /// @brief Get the current counter value without blocking
+  /// @param context GPU context reference for device access
+  /// @return Last value signaled on the semaphore
+  uint64_t getCounterValue(const Context& context) const;
+
+  /// @brief Block the host until the counter reaches a value
+  /// @param context GPU context reference for device access
+  /// @param value Value to wait for
+  /// @param timeout Timeout duration in nanoseconds
+  /// @return True if the value was reached within the timeout
+  bool wait(const Context& context,
+            uint64_t value,
+            uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
 };
 
 }  // namespace pandora::core::gpu
@@ -27,7 +27,9 @@ namespace pandora::core::gpu {
 /// This class wraps Vulkan shader modules and automatically parses shader
 /// descriptions using SPIRV-Cross reflection. The reflection provides
 /// semi-automated handling of shader resources, bindings, and interface
-/// information.
+/// information. Reflection results are stored in a sidecar file in the
+/// SPIR-V compile cache directory, keyed by a hash of the SPIR-V, so later
+/// modules built from the same binary skip SPIRV-Cross entirely.
 class ShaderModule {
  private:
   vk::UniqueShaderModule m_ptrShaderModule{};  ///< Vulkan shader module
@@ -37,6 +39,7 @@ class ShaderModule {
   std::unordered_map<std::string, PushConstantRange> m_pushConstantRangeMap;
 
   vk::ShaderStageFlagBits m_shaderStageFlag{};
+  uint64_t m_contentHash = 0u;  ///< Hash of the SPIR-V and entry point
 
  public:
   ShaderModule() = default;
@@ -65,6 +68,12 @@ class ShaderModule {
   const auto getShaderStageFlag() const {
     return m_shaderStageFlag;
   }
+  /// @brief Get hash identifying the shader's code
+  /// @details Modules built from the same SPIR-V share the value, so it can
+  /// key pipeline caches independently of the VkShaderModule handle.
+  uint64_t getContentHash() const {
+    return m_contentHash;
+  }
 };
 
 /// @brief Shader description integration unit
@@ -93,6 +102,10 @@ class DescriptionUnit {
   const auto& getPushConstantRangeMap() const {
     return m_pushConstantRangeMap;
   }
+
+  /// @brief Get descriptor set indices used by the shaders
+  /// @return Set indices in ascending order, without duplicates
+  std::vector<uint32_t> getSetIndices() const;
 };
 
 }  // namespace pandora::core::gpu
@@ -0,0 +1,159 @@
+/*
+ * staging_ring.hpp - Streaming staging ring buffer for Pandolabo Vulkan C++
+ * wrapper
+ *
+ * This header contains the StagingRing class which hands out upload regions
+ * from one persistently mapped buffer and recycles them once a timeline
+ * semaphore reports that the GPU has consumed them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "../error.hpp"
+#include "../types.hpp"
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Context;
+class Buffer;
+class TimelineSemaphore;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Behaviour of StagingRing when a reservation does not fit
+enum class StagingRingPolicy {
+  Block = 0u,  ///< Wait on the oldest in-flight timeline value
+  Grow,        ///< Switch to a larger buffer; the old one retires later
+};
+
+/// @brief Ring buffer for continuous CPU-to-GPU uploads
+/// @details Writers reserve variable-sized regions at the head of one
+/// persistently mapped staging buffer. commit() tags everything reserved since
+/// the previous commit with the timeline value the upload submission signals;
+/// the tail only advances past a region once the semaphore reaches that value.
+/// In steady state no buffer is created and memory use stays at the capacity.
+///
+/// Usage per frame:
+/// 1. reserve() regions and write into Region::data
+/// 2. Record copies from getBuffer() at Region::offset
+/// 3. commit(V), then submit signaling value V on the timeline semaphore
+///
+/// @note A region must be written before the next reserve() or commit().
+class StagingRing {
+ public:
+  /// @brief Region handed out by reserve()
+  struct Region {
+    std::reference_wrapper<const Buffer> buffer;
+    size_t offset = 0u;
+    std::span<std::byte> data{};
+  };
+
+ private:
+  /// @brief Bytes released together once the timeline reaches a value
+  struct Segment {
+    uint64_t value = 0u;
+    size_t end = 0u;   ///< Tail position after this segment retires
+    size_t size = 0u;  ///< Bytes including alignment padding and wrap waste
+  };
+
+  /// @brief Outgrown buffer kept alive until its last upload completes
+  struct RetiredBuffer {
+    std::unique_ptr<Buffer> ptr_buffer;
+    std::optional<uint64_t> value;  ///< Unset until the next commit()
+  };
+
+  std::reference_wrapper<const TimelineSemaphore> m_timelineSemaphore;
+  StagingRingPolicy m_policy = StagingRingPolicy::Block;
+  std::unique_ptr<Buffer> m_ptrBuffer;
+  size_t m_capacity = 0u;
+  size_t m_minAlignment = 4u;
+
+  size_t m_head = 0u;
+  size_t m_tail = 0u;
+  size_t m_usedSize = 0u;
+  size_t m_uncommittedSize = 0u;
+  size_t m_commitStart = 0u;
+
+  std::deque<Segment> m_segments;
+  std::vector<RetiredBuffer> m_retiredBuffers;
+
+ public:
+  /// @brief Construct ring with one persistently mapped staging buffer
+  /// @param context GPU context
+  /// @param timeline_semaphore Semaphore signaled by the upload submissions
+  /// @param capacity Ring size in bytes
+  /// @param policy What to do when the ring is full
+  StagingRing(const Context& context,
+              const TimelineSemaphore& timeline_semaphore,
+              size_t capacity,
+              StagingRingPolicy policy = StagingRingPolicy::Block);
+  ~StagingRing();
+
+  // Rule of Five
+  StagingRing(const StagingRing&) = delete;
+  StagingRing& operator=(const StagingRing&) = delete;
+  StagingRing(StagingRing&&) = default;
+  StagingRing& operator=(StagingRing&&) = default;
+
+  /// @brief Reserve a region at the head of the ring
+  /// @details Regions the GPU has consumed are reclaimed first. If the region
+  /// still does not fit, the ring blocks on the oldest in-flight value or
+  /// grows, depending on the policy.
+  /// @param context GPU context
+  /// @param size Size in bytes
+  /// @param alignment Extra alignment; offsets are always aligned to
+  /// optimalBufferCopyOffsetAlignment
+  /// @return Region to write, or an error if it can never fit
+  [[nodiscard]] Result<Region> reserve(const Context& context,
+                                       size_t size,
+                                       size_t alignment = 1u);
+
+  /// @brief Tag regions reserved since the last commit with a timeline value
+  /// @details Flushes the written range, so call it after writing and before
+  /// the submission that signals the value.
+  /// @param value Value the upload submission signals on the semaphore
+  void commit(uint64_t value);
+
+  /// @brief Reclaim regions whose timeline value has been reached
+  /// @param context GPU context
+  void retire(const Context& context);
+
+  /// @brief Get the current backing buffer
+  /// @return Staging buffer regions are currently carved from
+  const Buffer& getBuffer() const {
+    return *m_ptrBuffer;
+  }
+
+  /// @brief Get the timeline semaphore the ring waits on
+  const TimelineSemaphore& getTimelineSemaphore() const {
+    return m_timelineSemaphore.get();
+  }
+
+  /// @brief Get ring size in bytes
+  size_t getCapacity() const {
+    return m_capacity;
+  }
+
+  /// @brief Get bytes not yet reclaimed (in flight or uncommitted)
+  size_t getUsedSize() const {
+    return m_usedSize;
+  }
+
+ private:
+  std::optional<size_t> tryReserve(size_t size, size_t alignment);
+  void retireUpTo(uint64_t value);
+  void grow(const Context& context, size_t min_size);
+  void flushUncommitted() const;
+};
+
+}  // namespace pandora::core::gpu
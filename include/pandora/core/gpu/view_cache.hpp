@@ -0,0 +1,110 @@
+/*
+ * view_cache.hpp - Sampler and image view deduplication for Pandolabo Vulkan
+ * C++ wrapper
+ *
+ * This header contains the SamplerCache and ImageViewCache classes which hand
+ * out shared handles for identical create infos.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vulkan/vulkan.hpp>
+
+// Forward declarations
+namespace pandora::core::gpu {
+class Device;
+}  // namespace pandora::core::gpu
+
+namespace pandora::core::gpu {
+
+/// @brief Context-wide cache of samplers keyed by their create info
+/// @details Sampler objects with the same configuration share one VkSampler.
+/// The cache only keeps weak references: the handle is destroyed when the
+/// last Sampler using it dies, so the cache never extends lifetimes. This
+/// keeps texture-heavy scenes well below maxSamplerAllocationCount.
+class SamplerCache {
+ private:
+  struct Entry {
+    vk::SamplerCreateInfo create_info{};
+    std::weak_ptr<vk::UniqueSampler> ptr_sampler;
+  };
+
+  vk::Device m_device;
+  std::unordered_multimap<uint64_t, Entry> m_entries;
+  uint32_t m_insertsSincePurge = 0u;
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct empty cache
+  /// @param device Device the samplers are created on
+  explicit SamplerCache(const Device& device);
+  ~SamplerCache();
+
+  // Rule of Five
+  SamplerCache(const SamplerCache&) = delete;
+  SamplerCache& operator=(const SamplerCache&) = delete;
+  SamplerCache(SamplerCache&&) = delete;
+  SamplerCache& operator=(SamplerCache&&) = delete;
+
+  /// @brief Get a sampler with the given configuration
+  /// @param create_info Sampler create info (pNext must be null)
+  /// @return Shared sampler; created on a miss
+  std::shared_ptr<vk::UniqueSampler> acquire(
+      const vk::SamplerCreateInfo& create_info);
+
+  /// @brief Get number of distinct samplers currently alive
+  size_t getLiveCount() const;
+};
+
+/// @brief Context-wide cache of image views keyed by image and view range
+/// @details ImageView objects viewing the same subresource range of the same
+/// image with the same format share one VkImageView. Like SamplerCache, only
+/// weak references are kept, so the view dies with its last user. Entries are
+/// keyed by the VkImage handle, which the driver may hand out again once the
+/// image is destroyed; Image therefore calls purgeImage() on destruction so a
+/// recycled handle never hits a view of the old image.
+class ImageViewCache {
+ private:
+  struct Entry {
+    vk::ImageViewCreateInfo create_info{};
+    std::weak_ptr<vk::UniqueImageView> ptr_image_view;
+  };
+
+  vk::Device m_device;
+  std::unordered_multimap<uint64_t, Entry> m_entries;
+  uint32_t m_insertsSincePurge = 0u;
+  mutable std::mutex m_mutex;
+
+ public:
+  /// @brief Construct empty cache
+  /// @param device Device the image views are created on
+  explicit ImageViewCache(const Device& device);
+  ~ImageViewCache();
+
+  // Rule of Five
+  ImageViewCache(const ImageViewCache&) = delete;
+  ImageViewCache& operator=(const ImageViewCache&) = delete;
+  ImageViewCache(ImageViewCache&&) = delete;
+  ImageViewCache& operator=(ImageViewCache&&) = delete;
+
+  /// @brief Get an image view with the given configuration
+  /// @param create_info Image view create info (pNext must be null)
+  /// @return Shared image view; created on a miss
+  std::shared_ptr<vk::UniqueImageView> acquire(
+      const vk::ImageViewCreateInfo& create_info);
+
+  /// @brief Forget every view of an image about to be destroyed
+  /// @details Views still held by ImageView objects stay valid handles, but
+  /// are never returned by acquire() again.
+  /// @param image Image handle being destroyed
+  void purgeImage(vk::Image image);
+
+  /// @brief Get number of distinct image views currently alive
+  size_t getLiveCount() const;
+};
+
+}  // namespace pandora::core::gpu
@@ -11,6 +11,9 @@ namespace vk_helper {
 vk::MemoryPropertyFlags getMemoryPropertyFlags(
     pandora::core::MemoryUsage memory_usage);
 
+pandora::core::gpu::MemoryTypeRequest getMemoryTypeRequest(
+    pandora::core::MemoryUsage memory_usage);
+
 vk::AccessFlagBits2 getAccessFlagBits(pandora::core::AccessFlag access_flag);
 
 vk::PipelineStageFlagBits2 getPipelineStageFlagBits(
@@ -0,0 +1,74 @@
+/*
+ * hash.hpp - Incremental structural hashing for Pandolabo Vulkan C++ wrapper
+ *
+ * This header contains HashBuilder, used to derive 64-bit cache keys from
+ * Vulkan state without building intermediate strings.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vulkan/vulkan.hpp>
+
+namespace pandora::core {
+
+/// @brief Incremental 64-bit FNV-1a hasher
+/// @details Feed values field by field (never whole Vulkan structs, which
+/// carry pNext pointers and padding). Intermediate results can be stored and
+/// resumed with HashBuilder(seed), so parts that rarely change are hashed
+/// once and reused.
+class HashBuilder {
+ private:
+  static constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ull;
+  static constexpr uint64_t PRIME = 0x100000001b3ull;
+
+  uint64_t m_value = OFFSET_BASIS;
+
+ public:
+  HashBuilder() = default;
+
+  /// @brief Resume hashing from a previously computed value
+  /// @param seed Value returned by get()
+  explicit HashBuilder(uint64_t seed) : m_value(seed) {}
+
+  /// @brief Hash raw bytes
+  HashBuilder& addBytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0u; i < size; i += 1u) {
+      m_value ^= bytes[i];
+      m_value *= PRIME;
+    }
+    return *this;
+  }
+
+  /// @brief Hash an arithmetic or enum value
+  template <typename T>
+    requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+  HashBuilder& add(T value) {
+    return addBytes(&value, sizeof(value));
+  }
+
+  /// @brief Hash Vulkan flags
+  template <typename BitType>
+  HashBuilder& add(vk::Flags<BitType> flags) {
+    return add(static_cast<typename vk::Flags<BitType>::MaskType>(flags));
+  }
+
+  /// @brief Hash a contiguous range of arithmetic or enum values
+  template <typename T>
+    requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+  HashBuilder& add(std::span<const T> values) {
+    add(values.size());
+    return addBytes(values.data(), values.size_bytes());
+  }
+
+  /// @brief Get hash of everything added so far
+  uint64_t get() const {
+    return m_value;
+  }
+};
+
+}  // namespace pandora::core
@@ -2,9 +2,12 @@
  * io.hpp - Input/output operations for Pandolabo core module
  *
  * This header provides file I/O functionality for asset management including
- * shader code reading, compilation, and SPIR-V binary handling.
+ * shader code reading, compilation, SPIR-V binary handling, and the on-disk
+ * SPIR-V compile cache.
  */
 
+#include <cstdint>
+#include <filesystem>
 #include <string>
 #include <vector>
 
@@ -17,12 +20,29 @@
 /// Supports both GLSL source files and pre-compiled SPIR-V binaries.
 namespace pandora::core::io::shader {
 
+/// @brief Options of the SPIR-V optimization stage run after compilation
+/// Both options are off by default, so SPIR-V is used as glslang emits it.
+struct CompileOptions {
+  /// Run SPIRV-Tools performance passes, including dead-code elimination
+  bool optimize = false;
+  /// Remove source text, line info and non-semantic instructions. Names are
+  /// kept because descriptor reflection looks resources up by name.
+  bool strip_debug_info = false;
+
+  bool operator==(const CompileOptions&) const = default;
+};
+
 /// @brief Read and compile GLSL shader source to SPIR-V binary
 /// Reads GLSL source code from file and compiles it to SPIR-V binary format.
 /// Supports various shader types (.vert, .frag, .comp, etc.)
+/// A hit in the compile cache returns the stored SPIR-V without invoking
+/// glslang; a miss compiles, optimizes and stores the result. Optimized and
+/// unoptimized output are cached side by side.
 /// @param file_path Path to GLSL source file
+/// @param options Optimization stage options
 /// @return SPIR-V binary data as vector of 32-bit words
-Result<std::vector<uint32_t>> readText(const std::string& file_path);
+Result<std::vector<uint32_t>> readText(const std::string& file_path,
+                                       const CompileOptions& options = {});
 
 /// @brief Read pre-compiled SPIR-V binary from file
 /// Loads SPIR-V binary data directly from a .spv file without compilation.
@@ -34,9 +54,35 @@ Result<std::vector<uint32_t>> readBinary(const std::string& file_path);
 /// Automatically detects file format based on extension and reads accordingly:
 /// - .spv files: Read as pre-compiled SPIR-V binary
 /// - .vert, .frag, .comp, etc.: Compile GLSL source to SPIR-V
+/// Either way the result goes through the optimization stage. Optimized
+/// output of .spv files is stored in the compile cache under a hash of the
+/// binary, the SPIRV-Tools version and the options.
 /// @param file_path Path to shader file with appropriate extension
+/// @param options Optimization stage options
 /// @return SPIR-V binary data as vector of 32-bit words
-Result<std::vector<uint32_t>> read(const std::string& file_path);
+Result<std::vector<uint32_t>> read(const std::string& file_path,
+                                   const CompileOptions& options = {});
+
+/// @brief Read several shaders in parallel
+/// Each file is read as by read() on a pool of worker threads. glslang is
+/// initialized once for the whole batch, and compiles run concurrently.
+/// An exception thrown while reading one file becomes that file's error.
+/// @param file_paths Paths to shader files
+/// @param worker_count Number of threads; 0 uses hardware concurrency
+/// @param options Optimization stage options
+/// @return One result per file, in the order of file_paths
+std::vector<Result<std::vector<uint32_t>>> compileMany(
+    const std::vector<std::string>& file_paths,
+    uint32_t worker_count = 0u,
+    const CompileOptions& options = {});
+
+/// @brief Run the optimization stage on a SPIR-V binary
+/// Returns the binary unchanged when no option is enabled.
+/// @param shader_binary SPIR-V binary data
+/// @param options Optimization stage options
+/// @return Optimized SPIR-V, or a validation error from SPIRV-Tools
+Result<std::vector<uint32_t>> optimize(
+    const std::vector<uint32_t>& shader_binary, const CompileOptions& options);
 
 /// @brief Write SPIR-V binary to file
 /// Saves SPIR-V binary data to a file for later use or distribution.
@@ -45,4 +91,27 @@ Result<std::vector<uint32_t>> read(const std::string& file_path);
 VoidResult write(const std::string& file_path,
                  const std::vector<uint32_t>& shader_binary);
 
+/// @brief Set directory of the SPIR-V compile cache used by readText
+/// Entries are named after a 64-bit hash of the source text, shader stage,
+/// target SPIR-V version, glslang and SPIRV-Tools versions and compile
+/// options, so an edited shader or an upgraded compiler never hits a stale
+/// entry. Defaults to
+/// "pandolabo/spirv_cache" under the system temporary directory.
+/// @param directory Cache directory; an empty path disables the cache
+void setCompileCacheDirectory(std::filesystem::path directory);
+
+/// @brief Get directory of the SPIR-V compile cache
+/// @return Cache directory, or an empty path if the cache is disabled
+std::filesystem::path getCompileCacheDirectory();
+
+/// @brief Set the size bound of the compile cache directory
+/// After a new entry is written, the oldest files in the directory are
+/// removed until it is back under the limit. Defaults to 64 MiB.
+/// @param size_limit Limit in bytes; 0 leaves the directory unbounded
+void setCompileCacheSizeLimit(uint64_t size_limit);
+
+/// @brief Get the size bound of the compile cache directory
+/// @return Limit in bytes, or 0 if the directory is unbounded
+uint64_t getCompileCacheSizeLimit();
+
 }  // namespace pandora::core::io::shader
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -430,6 +432,12 @@ struct GraphicInfo {
 
   // Move assignment operator
   GraphicInfo& operator=(GraphicInfo&& other) noexcept = default;
+
+  /// @brief Hash every fixed-function state that affects pipeline creation
+  /// @details Equal states give equal hashes, whichever builder produced them.
+  /// Viewport and scissor are skipped when they are dynamic states.
+  /// @return 64-bit structural hash
+  uint64_t computeHash() const;
 };
 
 /// @brief Builder class for GraphicInfo
@@ -537,12 +545,32 @@ class GraphicInfoBuilder {
 /// as they are tightly coupled and separation is not necessary for most use
 /// cases.
 class Pipeline {
+ public:
+  /// @brief One compute pipeline of a constructComputePipelines() batch
+  struct ComputePipelineTarget {
+    Pipeline& pipeline;  ///< Pipeline with its layout already constructed
+    const gpu::ShaderModule& shader_module;
+  };
+
+  /// @brief One graphics pipeline of a constructGraphicsPipelines() batch
+  /// @details Arguments match constructGraphicsPipeline().
+  struct GraphicsPipelineTarget {
+    Pipeline& pipeline;  ///< Pipeline with its layout already constructed
+    const std::unordered_map<std::string, gpu::ShaderModule>&
+        shader_module_map;
+    const std::vector<std::string>& module_keys;
+    const pipeline::GraphicInfo& graphic_info;
+    const Renderpass& render_pass;
+    uint32_t subpass_index = 0u;
+  };
+
  protected:
-  vk::UniquePipeline m_ptrPipeline;              ///< Vulkan pipeline object
-  vk::UniquePipelineLayout m_ptrPipelineLayout;  ///< Vulkan pipeline layout
+  vk::UniquePipeline m_ptrPipeline;     ///< Vulkan pipeline object
+  vk::PipelineLayout m_pipelineLayout;  ///< Shared layout owned by LayoutCache
   QueueFamilyType m_queueFamilyType{};  ///< Queue family type for this pipeline
   vk::PipelineBindPoint
       m_bindPoint{};  ///< Pipeline bind point (graphics or compute)
+  gpu::TrackedResourceToken m_trackingToken;  ///< Live pipeline count entry
 
  public:
   Pipeline(const gpu::Context& context,
@@ -550,6 +578,32 @@ class Pipeline {
            const gpu::DescriptorSetLayout& descriptor_set_layout,
            PipelineBind bind_point);
 
+  /// @brief Construct pipeline layout with one descriptor set per layout
+  /// @details Each layout is placed at its DescriptorSetLayout::getSetIndex();
+  /// unused set indices below the highest one get an empty layout. Sets can
+  /// then be bound independently, so only the set that changed is rebound.
+  /// @param context Vulkan context for device operations
+  /// @param description_unit Description unit providing push constant ranges
+  /// @param descriptor_set_layouts Layouts of the sets, in any order
+  /// @param bind_point Graphics or compute
+  Pipeline(const gpu::Context& context,
+           const gpu::DescriptionUnit& description_unit,
+           const std::vector<std::reference_wrapper<
+               const gpu::DescriptorSetLayout>>& descriptor_set_layouts,
+           PipelineBind bind_point);
+
+  /// @brief Construct pipeline layout around a bindless heap
+  /// @details Set 0 is the heap's set; push constant ranges still come from
+  /// the description unit and carry the resource indices.
+  /// @param context Vulkan context for device operations
+  /// @param description_unit Description unit providing push constant ranges
+  /// @param bindless_heap Heap whose set layout becomes set 0
+  /// @param bind_point Graphics or compute
+  Pipeline(const gpu::Context& context,
+           const gpu::DescriptionUnit& description_unit,
+           const gpu::BindlessHeap& bindless_heap,
+           PipelineBind bind_point);
+
   // Rule of Five
   ~Pipeline();
   Pipeline(const Pipeline&) = delete;
@@ -561,7 +615,7 @@ class Pipeline {
     return m_ptrPipeline.get();
   }
   const auto& getPipelineLayout() const {
-    return m_ptrPipelineLayout.get();
+    return m_pipelineLayout;
   }
   auto getQueueFamilyType() const {
     return m_queueFamilyType;
@@ -591,6 +645,31 @@ class Pipeline {
       pipeline::GraphicInfo& graphic_info,
       const Renderpass& render_pass,
       uint32_t subpass_index);
+
+  /// @brief Construct several compute pipelines with one driver call
+  /// @details Thread-safe as long as batches do not share Pipeline objects;
+  /// all of them go through the context's pipeline cache.
+  /// @param context Vulkan context for device operations
+  /// @param targets Pipelines and their shaders
+  static void constructComputePipelines(
+      const gpu::Context& context,
+      std::span<const ComputePipelineTarget> targets);
+
+  /// @brief Construct several graphics pipelines with one driver call
+  /// @details Thread-safe as long as batches do not share Pipeline objects;
+  /// GraphicInfo is only read and may be shared.
+  /// @param context Vulkan context for device operations
+  /// @param targets Pipelines and their graphics state
+  static void constructGraphicsPipelines(
+      const gpu::Context& context,
+      std::span<const GraphicsPipelineTarget> targets);
+
+ private:
+  void constructPipelineLayout(
+      const gpu::Context& context,
+      const gpu::DescriptionUnit& description_unit,
+      const std::vector<vk::DescriptorSetLayout>& descriptor_set_layouts,
+      PipelineBind bind_point);
 };
 
 }  // namespace pandora::core
@@ -258,6 +258,7 @@ class SubpassGraph {
 class Renderpass {
  private:
   vk::UniqueRenderPass m_ptrRenderPass;  ///< Unique Vulkan render pass handle
+  uint64_t m_compatibilityHash = 0u;     ///< See getCompatibilityHash()
 
  public:
   /// @brief Construct render pass from attachments and subpass graph
@@ -280,6 +281,16 @@ class Renderpass {
   const auto& getRenderPass() const {
     return m_ptrRenderPass.get();
   }
+
+  /// @brief Get hash shared by compatible render passes
+  /// @details Covers attachment formats and sample counts, subpass attachment
+  /// references (preserve attachments included) and dependencies, but not
+  /// load/store ops or image layouts, following the Vulkan render pass
+  /// compatibility rules. A pipeline built for one render pass can be used
+  /// with any other of equal hash.
+  uint64_t getCompatibilityHash() const {
+    return m_compatibilityHash;
+  }
 };
 
 /// @brief Vulkan framebuffer wrapper
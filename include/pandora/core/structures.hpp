@@ -66,6 +66,7 @@ struct ImageSubInfo {
 struct DescriptorInfo {
   vk::ShaderStageFlags
       stage_flags{};      ///< Which shader stages can access this resource
+  uint32_t set = 0u;      ///< Descriptor set index (layout(set = N))
   uint32_t binding = 0u;  ///< Binding index in the descriptor set layout
   vk::DescriptorType
       type{};          ///< Type of descriptor (uniform buffer, sampler, etc.)
@@ -76,6 +77,10 @@ struct DescriptorInfo {
     stage_flags = flags;
     return *this;
   }
+  DescriptorInfo& setSet(uint32_t set_index) {
+    set = set_index;
+    return *this;
+  }
   DescriptorInfo& setBinding(uint32_t bind) {
     binding = bind;
     return *this;
@@ -114,6 +119,29 @@ struct PushConstantRange {
   }
 };
 
+/// @brief Buffer copy region for multi-region buffer copies
+/// Describes one contiguous range copied from a source buffer to a destination
+/// buffer
+struct BufferCopyRegion {
+  size_t src_offset = 0u;  ///< Byte offset in the source buffer
+  size_t dst_offset = 0u;  ///< Byte offset in the destination buffer
+  size_t size = 0u;        ///< Number of bytes to copy
+
+  // Fluent interface methods
+  BufferCopyRegion& setSrcOffset(size_t byte_offset) {
+    src_offset = byte_offset;
+    return *this;
+  }
+  BufferCopyRegion& setDstOffset(size_t byte_offset) {
+    dst_offset = byte_offset;
+    return *this;
+  }
+  BufferCopyRegion& setSize(size_t byte_size) {
+    size = byte_size;
+    return *this;
+  }
+};
+
 /// @brief Image view information for image resource access
 /// @details This struct is not only for image view, but also for image barrier,
 /// etc. It's useful to manage image's miplevel and array layers.
@@ -25,6 +25,15 @@ enum class MemoryUsage {
   GpuToCpu,
 };
 
+/// @brief Device memory allocation strategies
+/// @details Pooled resources share large memory blocks owned by the context.
+/// Dedicated resources get their own memory object (large render targets,
+/// resources that are created and destroyed rarely).
+enum class AllocationStrategy {
+  Pooled = 0u,
+  Dedicated,
+};
+
 /// @brief Transfer operation types
 enum class TransferType {
   Unknown = 0u,
@@ -2,8 +2,10 @@
 
 #include "pandora/highlevel/compute_runner.hpp"
 #include "pandora/highlevel/error_collector.hpp"
+#include "pandora/highlevel/frame_allocator.hpp"
 #include "pandora/highlevel/frame_context.hpp"
 #include "pandora/highlevel/pipeline_cache.hpp"
+#include "pandora/highlevel/pipeline_compiler.hpp"
 #include "pandora/highlevel/renderer.hpp"
 #include "pandora/highlevel/resource_transfer.hpp"
 #include "pandora/highlevel/shader_library.hpp"
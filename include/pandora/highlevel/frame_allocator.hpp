@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "pandora/core/error.hpp"
+#include "pandora/core/gpu.hpp"
+
+namespace pandora::highlevel {
+
+/// @brief Per-frame linear allocator for transient uniform and vertex data.
+/// @details Owns one persistently mapped buffer per frame in flight and hands
+/// out aligned sub-ranges of it. A frame's buffer is reset wholesale when the
+/// Renderer has waited on that frame's fence, so no buffer is created in
+/// steady state.
+class FrameAllocator {
+ public:
+  /// @brief Sub-range handed out for the current frame.
+  struct Allocation {
+    std::reference_wrapper<const pandora::core::gpu::Buffer> buffer;
+    uint32_t offset = 0u;
+    std::span<std::byte> data{};
+  };
+
+ private:
+  std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
+  std::vector<std::unique_ptr<pandora::core::gpu::Buffer>> m_frameBuffers;
+  std::vector<pandora::core::BufferUsage> m_bufferUsages;
+  size_t m_capacity = 0u;
+  size_t m_minAlignment = 1u;
+  uint32_t m_frameIndex = 0u;
+  size_t m_head = 0u;
+
+  const pandora::core::gpu::Buffer& ensureFrameBuffer(uint32_t frame_index);
+
+ public:
+  /// @brief Create allocator with one buffer per frame in flight.
+  /// @param context GPU context
+  /// @param capacity Bytes available per frame
+  /// @param frame_count Number of frames in flight (swapchain image count)
+  /// @param buffer_usages Usages of the backing buffers
+  FrameAllocator(const pandora::core::gpu::Context& context,
+                 size_t capacity,
+                 uint32_t frame_count,
+                 const std::vector<pandora::core::BufferUsage>& buffer_usages =
+                     {pandora::core::BufferUsage::UniformBuffer,
+                      pandora::core::BufferUsage::StorageBuffer,
+                      pandora::core::BufferUsage::VertexBuffer,
+                      pandora::core::BufferUsage::IndexBuffer});
+
+  /// @brief Switch to a frame and discard its previous allocations.
+  /// @details Only call once the GPU has finished with this frame (Renderer
+  /// calls it right after waiting on the frame fence).
+  void reset(uint32_t frame_index);
+
+  /// @brief Allocate an aligned sub-range from the current frame's buffer.
+  /// @param size Size in bytes
+  /// @param alignment Extra alignment; the result is always aligned to
+  /// minUniformBufferOffsetAlignment and minStorageBufferOffsetAlignment
+  [[nodiscard]] pandora::core::Result<Allocation> allocate(
+      size_t size, size_t alignment = 1u);
+
+  /// @brief Allocate a sub-range and copy data into it.
+  [[nodiscard]] pandora::core::Result<Allocation> push(
+      std::span<const std::byte> data, size_t alignment = 1u);
+
+  /// @brief Make this frame's host writes visible to the device.
+  void flush() const;
+
+  /// @brief Get the current frame's backing buffer (for descriptor writes).
+  const pandora::core::gpu::Buffer& getBuffer() const {
+    return *m_frameBuffers.at(m_frameIndex);
+  }
+
+  /// @brief Get the buffer of a specific frame (for per-frame descriptor sets).
+  const pandora::core::gpu::Buffer& getBuffer(uint32_t frame_index) const {
+    return *m_frameBuffers.at(frame_index);
+  }
+
+  /// @brief Get bytes allocated in the current frame.
+  size_t getUsedSize() const {
+    return m_head;
+  }
+
+  /// @brief Get bytes available per frame.
+  size_t getCapacity() const {
+    return m_capacity;
+  }
+};
+
+}  // namespace pandora::highlevel
@@ -1,33 +1,132 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "pandora/core/pipeline.hpp"
 
 namespace pandora::highlevel {
 
 /// @brief Thin cache for graphics/compute pipelines.
+/// @details Pipelines are keyed by everything that affects creation: set
+/// layouts and push constant ranges, shader code, fixed-function state,
+/// render pass compatibility and subpass index. Call sites that describe the
+/// same pipeline therefore share one object without agreeing on a name. Like
+/// LayoutCache, lookups go through a 64-bit hash of the key parts and then
+/// compare the parts themselves, so a collision of that combined hash never
+/// returns the wrong pipeline. Shader code, fixed-function state and render
+/// pass compatibility enter the parts only as 64-bit digests
+/// (ShaderModule::getContentHash(), GraphicInfo::computeHash() and
+/// Renderpass::getCompatibilityHash()); a collision within one of those
+/// digests is not detected. Each entry remembers the content hashes of its
+/// shader modules, so evictShader() can drop the pipelines a reloaded shader
+/// makes stale; the next getOrCreate*() call with the new module rebuilds
+/// them.
 class PipelineCache {
  public:
   using PipelineBuilder =
       std::function<std::unique_ptr<pandora::core::Pipeline>(
           const pandora::core::gpu::Context&)>;
+  using SetLayoutList = std::vector<
+      std::reference_wrapper<const pandora::core::gpu::DescriptorSetLayout>>;
+
+  /// @brief Pipeline key: the values describing a pipeline and their hash
+  struct Key {
+    uint64_t hash = 0u;          ///< Hash of parts, used for bucket lookup
+    std::vector<uint64_t> parts;  ///< Compared on a hash match
+  };
 
  private:
+  /// Keys are already well mixed, so they are used as bucket hashes directly
+  struct KeyHash {
+    size_t operator()(uint64_t key) const noexcept {
+      return static_cast<size_t>(key);
+    }
+  };
+
+  struct Entry {
+    std::vector<uint64_t> key_parts;
+    std::unique_ptr<pandora::core::Pipeline> ptr_pipeline;
+    std::vector<uint64_t> shader_hashes;  ///< ShaderModule content hashes
+  };
+
   std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
-  std::unordered_map<std::string, std::unique_ptr<pandora::core::Pipeline>>
-      m_cache;
+  std::unordered_multimap<uint64_t, Entry, KeyHash> m_cache;
 
  public:
   explicit PipelineCache(const pandora::core::gpu::Context& context)
       : m_contextOwner(context) {}
 
   /// @brief Get cached pipeline or create it using builder.
-  pandora::core::Pipeline& getOrCreate(const std::string& key,
-                                       const PipelineBuilder& builder);
+  /// @param key Key from makeComputeKey()/makeGraphicsKey()
+  /// @param shader_hashes Content hashes of the shader modules the builder
+  /// uses, for evictShader()
+  pandora::core::Pipeline& getOrCreate(
+      const Key& key,
+      const PipelineBuilder& builder,
+      std::vector<uint64_t> shader_hashes = {});
+
+  /// @brief Get cached pipeline or create it using builder.
+  /// @param key Caller-defined 64-bit identity of the pipeline state; two
+  /// pipelines given the same value share one entry
+  /// @param shader_hashes Content hashes of the shader modules the builder
+  /// uses, for evictShader()
+  pandora::core::Pipeline& getOrCreate(
+      uint64_t key,
+      const PipelineBuilder& builder,
+      std::vector<uint64_t> shader_hashes = {});
+
+  /// @brief Get cached compute pipeline or create it.
+  pandora::core::Pipeline& getOrCreateCompute(
+      const pandora::core::gpu::DescriptionUnit& description_unit,
+      const SetLayoutList& descriptor_set_layouts,
+      const pandora::core::gpu::ShaderModule& shader_module);
+
+  /// @brief Get cached graphics pipeline or create it.
+  pandora::core::Pipeline& getOrCreateGraphics(
+      const pandora::core::gpu::DescriptionUnit& description_unit,
+      const SetLayoutList& descriptor_set_layouts,
+      const std::unordered_map<std::string, pandora::core::gpu::ShaderModule>&
+          shader_module_map,
+      const std::vector<std::string>& module_keys,
+      pandora::core::pipeline::GraphicInfo& graphic_info,
+      const pandora::core::Renderpass& render_pass,
+      uint32_t subpass_index);
+
+  /// @brief Derive key of a compute pipeline.
+  static Key makeComputeKey(
+      const pandora::core::gpu::DescriptionUnit& description_unit,
+      const SetLayoutList& descriptor_set_layouts,
+      const pandora::core::gpu::ShaderModule& shader_module);
+
+  /// @brief Derive key of a graphics pipeline.
+  static Key makeGraphicsKey(
+      const pandora::core::gpu::DescriptionUnit& description_unit,
+      const SetLayoutList& descriptor_set_layouts,
+      const std::unordered_map<std::string, pandora::core::gpu::ShaderModule>&
+          shader_module_map,
+      const std::vector<std::string>& module_keys,
+      const pandora::core::pipeline::GraphicInfo& graphic_info,
+      const pandora::core::Renderpass& render_pass,
+      uint32_t subpass_index);
+
+  /// @brief Remove every pipeline built from a shader module.
+  /// @details References to the removed pipelines become invalid once the
+  /// returned objects are destroyed; hand them to deferred destruction and
+  /// fetch replacements through getOrCreate*().
+  /// @param shader_content_hash ShaderModule::getContentHash() of the module
+  /// @return Removed pipelines
+  [[nodiscard]] std::vector<std::unique_ptr<pandora::core::Pipeline>>
+  evictShader(uint64_t shader_content_hash);
+
+  /// @brief Get number of cached pipelines.
+  size_t size() const {
+    return m_cache.size();
+  }
 };
 
 }  // namespace pandora::highlevel
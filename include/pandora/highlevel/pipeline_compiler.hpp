@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pandora/core/error.hpp"
+#include "pandora/core/pipeline.hpp"
+
+namespace pandora::highlevel {
+
+/// @brief Compile pipeline batches on a pool of worker threads.
+/// @details A batch is split into chunks and every chunk is created with one
+/// multi-create-info vkCreate*Pipelines call, so the driver compiles chunks
+/// in parallel while sharing the context's VkPipelineCache. The Pipeline
+/// objects must already hold their layouts (constructed with a
+/// DescriptionUnit) and, together with everything the targets refer to, must
+/// stay alive until the returned future is ready.
+class PipelineCompiler {
+ public:
+  using ComputeTarget = pandora::core::Pipeline::ComputePipelineTarget;
+  using GraphicsTarget = pandora::core::Pipeline::GraphicsPipelineTarget;
+  using CompletionFn = std::function<void(const pandora::core::VoidResult&)>;
+
+ private:
+  std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
+  uint32_t m_chunkSize;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::function<void()>> m_tasks;
+  bool m_isStopping = false;
+  std::vector<std::jthread> m_workers;
+
+  void enqueue(std::vector<std::function<void()>> tasks);
+  void workerLoop();
+
+  template <typename Target>
+  std::future<pandora::core::VoidResult> dispatch(
+      std::vector<Target> targets, CompletionFn on_complete, const char* name);
+
+ public:
+  /// @brief Start worker threads.
+  /// @param context Context the pipelines are created on
+  /// @param worker_count Number of threads; 0 uses hardware concurrency
+  /// @param chunk_size Maximum pipelines per vkCreate*Pipelines call
+  explicit PipelineCompiler(const pandora::core::gpu::Context& context,
+                            uint32_t worker_count = 0u,
+                            uint32_t chunk_size = 16u);
+  ~PipelineCompiler();
+
+  // Rule of Five
+  PipelineCompiler(const PipelineCompiler&) = delete;
+  PipelineCompiler& operator=(const PipelineCompiler&) = delete;
+  PipelineCompiler(PipelineCompiler&&) = delete;
+  PipelineCompiler& operator=(PipelineCompiler&&) = delete;
+
+  /// @brief Compile compute pipelines in the background.
+  /// @param targets Pipelines to construct
+  /// @param on_complete Optional callback run once the whole batch has
+  /// finished, before the future becomes ready. It runs on a worker thread
+  /// (on the calling thread for an empty batch), so it must synchronize any
+  /// state it shares; an exception it throws is returned through the future
+  /// @return Future holding the first error of the batch, if any
+  [[nodiscard]] std::future<pandora::core::VoidResult> compileCompute(
+      std::vector<ComputeTarget> targets, CompletionFn on_complete = {});
+
+  /// @brief Compile graphics pipelines in the background.
+  /// @param targets Pipelines to construct
+  /// @param on_complete Optional callback run once the whole batch has
+  /// finished, before the future becomes ready. It runs on a worker thread
+  /// (on the calling thread for an empty batch), so it must synchronize any
+  /// state it shares; an exception it throws is returned through the future
+  /// @return Future holding the first error of the batch, if any
+  [[nodiscard]] std::future<pandora::core::VoidResult> compileGraphics(
+      std::vector<GraphicsTarget> targets, CompletionFn on_complete = {});
+
+  /// @brief Get number of worker threads.
+  uint32_t getWorkerCount() const {
+    return static_cast<uint32_t>(m_workers.size());
+  }
+};
+
+}  // namespace pandora::highlevel
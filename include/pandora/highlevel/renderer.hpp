@@ -10,6 +10,7 @@
 #include "pandora/core/renderpass.hpp"
 #include "pandora/core/synchronization.hpp"
 #include "pandora/core/ui.hpp"
+#include "pandora/highlevel/frame_allocator.hpp"
 #include "pandora/highlevel/frame_context.hpp"
 
 namespace pandora::highlevel {
@@ -25,6 +26,7 @@ class Renderer {
   std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
   std::vector<std::unique_ptr<pandora::core::CommandDriver>> m_graphicDrivers;
   std::optional<std::reference_wrapper<pandora::core::RenderKit>> m_renderKit;
+  std::optional<std::reference_wrapper<FrameAllocator>> m_frameAllocator;
 
  public:
   Renderer(const pandora::core::ui::Window& window,
@@ -35,7 +37,13 @@ class Renderer {
     m_renderKit = render_kit;
   }
 
-  /// @brief Acquire image and build per-frame context.
+  /// @brief Set frame allocator reset on beginFrame and flushed on endFrame.
+  void setFrameAllocator(FrameAllocator& frame_allocator) {
+    m_frameAllocator = frame_allocator;
+  }
+
+  /// @brief Acquire image, collect deferred destructions, close the previous
+  /// frame's allocation statistics and build per-frame context.
   [[nodiscard]] pandora::core::Result<FrameContext> beginFrame();
 
   /// @brief Record commands on the frame's command buffer.
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <deque>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
@@ -76,6 +78,12 @@ class TransferPlan {
   TransferPlan& copyBuffer(const pandora::core::gpu::Buffer& src,
                            const pandora::core::gpu::Buffer& dst);
 
+  /// @brief Record a multi-region buffer copy command.
+  TransferPlan& copyBufferRegions(
+      const pandora::core::gpu::Buffer& src,
+      const pandora::core::gpu::Buffer& dst,
+      const std::vector<pandora::core::BufferCopyRegion>& regions);
+
   /// @brief Record a buffer-to-image copy command.
   TransferPlan& copyBufferToImage(
       const pandora::core::gpu::Buffer& src,
@@ -98,23 +106,124 @@ class TransferPlan {
   void reset();
 };
 
+/// @brief Packs many small buffer uploads into one staging buffer.
+/// @details Uploads are gathered with add() and written into a single staging
+/// buffer by record(), which emits one multi-region copy per destination on a
+/// TransferPlan. Submitting the plan then sends everything in one submission.
+/// The batch owns the staging buffer, so keep it alive until that submission
+/// has completed. Destinations in host-visible device-local memory are
+/// written in place by record() instead.
+class UploadBatch {
+ private:
+  struct PendingUpload {
+    std::reference_wrapper<const pandora::core::gpu::Buffer> dst;
+    std::span<const std::byte> data;
+    size_t dst_offset = 0u;
+    bool is_direct = false;  ///< Written in place, no staging copy
+  };
+
+  std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
+  std::vector<PendingUpload> m_uploads;
+  std::unique_ptr<pandora::core::gpu::Buffer> m_ptrStaging;
+  size_t m_copyAlignment = 4u;
+  size_t m_stagingSize = 0u;
+
+ public:
+  explicit UploadBatch(const pandora::core::gpu::Context& context);
+
+  /// @brief Queue an upload.
+  /// @details `data` is not copied until record(); it must stay valid until
+  /// then.
+  [[nodiscard]] pandora::core::VoidResult add(
+      const pandora::core::gpu::Buffer& dst,
+      std::span<const std::byte> data,
+      size_t dst_offset = 0u);
+
+  /// @brief Fill the staging buffer and record the copies on a plan.
+  [[nodiscard]] pandora::core::VoidResult record(TransferPlan& plan);
+
+  /// @brief Get total staging bytes required by the queued uploads.
+  size_t getStagingSize() const {
+    return m_stagingSize;
+  }
+
+  /// @brief Get number of queued uploads.
+  size_t getUploadCount() const {
+    return m_uploads.size();
+  }
+
+  /// @brief Drop queued uploads and the staging buffer.
+  /// @details Only call once the submission that used the batch completed.
+  void reset();
+};
+
+/// @brief Completion handle of an asynchronous transfer.
+/// @details The transfer is complete once the timeline semaphore reaches the
+/// value. Add it as a wait to a later submission, or poll/wait on the host.
+struct TransferTicket {
+  std::reference_wrapper<const pandora::core::gpu::TimelineSemaphore>
+      semaphore;
+  uint64_t value = 0u;
+
+  /// @brief Build a wait entry for a later SubmitSemaphoreGroup.
+  pandora::core::SubmitSemaphore asWaitSemaphore(
+      pandora::core::PipelineStage stage_mask =
+          pandora::core::PipelineStage::AllCommands) const {
+    return pandora::core::SubmitSemaphore{}
+        .setSemaphore(semaphore.get())
+        .setValue(value)
+        .setStageMask(stage_mask);
+  }
+};
+
 /// @brief Template transfer utility for upload/readback.
 class ResourceTransfer {
  private:
+  /// @brief In-flight asynchronous transfer and the resources it keeps alive.
+  struct PendingTransfer {
+    uint64_t value = 0u;
+    pandora::core::gpu::Buffer staging;
+    std::unique_ptr<pandora::core::CommandDriver> driver;
+    std::span<std::byte> readback_out{};
+  };
+
   std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
   std::unique_ptr<pandora::core::CommandDriver> m_transferDriver;
   pandora::core::QueueFamilyType m_queueFamilyType =
       pandora::core::QueueFamilyType::Transfer;
 
+  std::unique_ptr<pandora::core::gpu::TimelineSemaphore> m_ptrTimeline;
+  uint64_t m_lastSubmittedValue = 0u;
+  std::deque<PendingTransfer> m_pendingTransfers;
+  std::vector<std::unique_ptr<pandora::core::CommandDriver>> m_idleDrivers;
+
   pandora::core::CommandDriver& ensureDriver();
+  pandora::core::gpu::TimelineSemaphore& ensureTimeline();
+  pandora::core::Result<TransferTicket> submitAsync(
+      pandora::core::gpu::Buffer&& staging,
+      std::span<std::byte> readback_out,
+      const std::function<void(pandora::core::TransferCommandBuffer&,
+                               const pandora::core::gpu::Buffer&)>& record_fn);
+  void retireUpTo(uint64_t completed_value);
 
  public:
   explicit ResourceTransfer(const pandora::core::gpu::Context& context,
                             pandora::core::QueueFamilyType queue_family_type =
                                 pandora::core::QueueFamilyType::Transfer)
       : m_contextOwner(context), m_queueFamilyType(queue_family_type) {}
+  ~ResourceTransfer();
+
+  ResourceTransfer(const ResourceTransfer&) = delete;
+  ResourceTransfer& operator=(const ResourceTransfer&) = delete;
+  ResourceTransfer(ResourceTransfer&&) = default;
+  // Assigning over a live transfer would free staging memory the GPU may
+  // still read, and tickets refer to the timeline it owns
+  ResourceTransfer& operator=(ResourceTransfer&&) = delete;
 
   /// @brief Upload data to a GPU buffer via staging.
+  /// @details Host-visible device-local destinations are written in place
+  /// (see MemoryAllocator::isDirectWriteAvailable); the GPU must not be
+  /// reading them at that point.
   [[nodiscard]] pandora::core::VoidResult uploadBuffer(
       pandora::core::gpu::Buffer& dst, std::span<const std::byte> data);
 
@@ -127,6 +236,45 @@ class ResourceTransfer {
   /// @brief Read back buffer data into CPU memory.
   [[nodiscard]] pandora::core::VoidResult readbackBuffer(
       pandora::core::gpu::Buffer& src, std::span<std::byte> out);
+
+  /// @brief Upload data to a GPU buffer without waiting for completion.
+  /// @details The data is copied into staging memory before returning; the
+  /// staging buffer is released once the ticket completes. Host-visible
+  /// device-local destinations are written in place and the returned ticket
+  /// is already complete.
+  [[nodiscard]] pandora::core::Result<TransferTicket> uploadBufferAsync(
+      pandora::core::gpu::Buffer& dst, std::span<const std::byte> data);
+
+  /// @brief Upload data to a GPU image without waiting for completion.
+  /// @details The image must already be in TransferDstOptimal layout when the
+  /// copy executes.
+  [[nodiscard]] pandora::core::Result<TransferTicket> uploadImageAsync(
+      pandora::core::gpu::Image& dst,
+      const pandora::core::ImageViewInfo& view_info,
+      std::span<const std::byte> data);
+
+  /// @brief Read back buffer data without waiting for completion.
+  /// @details `out` must stay alive until the ticket is retired; it is filled
+  /// by wait() or collectCompleted() once the copy has finished.
+  [[nodiscard]] pandora::core::Result<TransferTicket> readbackBufferAsync(
+      pandora::core::gpu::Buffer& src, std::span<std::byte> out);
+
+  /// @brief Check whether a ticket has completed (non-blocking).
+  bool isComplete(const TransferTicket& ticket) const;
+
+  /// @brief Block until a ticket completes and retire finished transfers.
+  [[nodiscard]] pandora::core::VoidResult wait(
+      const TransferTicket& ticket,
+      uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+  /// @brief Retire every finished transfer (staging, command buffers,
+  /// readback copies) without blocking.
+  void collectCompleted();
+
+  /// @brief Get number of transfers still in flight.
+  size_t getPendingCount() const {
+    return m_pendingTransfers.size();
+  }
 };
 
 }  // namespace pandora::highlevel
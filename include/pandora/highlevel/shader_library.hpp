@@ -2,26 +2,99 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "pandora/core/gpu/shader.hpp"
 #include "pandora/core/io.hpp"
 
+// Forward declarations
+namespace pandora::core::gpu {
+class Fence;
+}  // namespace pandora::core::gpu
+
 namespace pandora::highlevel {
 
+class PipelineCache;
+
 /// @brief Thin wrapper around shader I/O and module creation.
+/// @details Shaders loaded with loadWatched() can be hot-reloaded: after
+/// startWatching(), a background thread waits for the files to change
+/// (inotify on Linux, modification-time polling elsewhere), recompiles only
+/// the changed ones and creates their modules. applyReloads() then swaps the
+/// modules in on the calling thread.
+/// Every shader the library loads goes through the SPIR-V optimization stage
+/// configured by its CompileOptions.
 class ShaderLibrary {
  private:
+  struct WatchState;
+
   std::reference_wrapper<const pandora::core::gpu::Context> m_contextOwner;
+  std::unique_ptr<WatchState> m_ptrWatchState;
 
  public:
   /// @brief Construct with a context owner.
-  explicit ShaderLibrary(const pandora::core::gpu::Context& context)
-      : m_contextOwner(context) {}
+  /// @param compile_options Optimization stage options of loaded shaders
+  explicit ShaderLibrary(
+      const pandora::core::gpu::Context& context,
+      const pandora::core::io::shader::CompileOptions& compile_options = {});
+  ~ShaderLibrary();
+
+  // Rule of Five
+  ShaderLibrary(const ShaderLibrary&) = delete;
+  ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+  ShaderLibrary(ShaderLibrary&&) = delete;
+  ShaderLibrary& operator=(ShaderLibrary&&) = delete;
+
+  /// @brief Set optimization stage options of shaders loaded from now on.
+  void setCompileOptions(
+      const pandora::core::io::shader::CompileOptions& compile_options);
+
+  /// @brief Get optimization stage options.
+  pandora::core::io::shader::CompileOptions getCompileOptions() const;
 
   /// @brief Load shader and create a module.
   [[nodiscard]] pandora::core::Result<pandora::core::gpu::ShaderModule> load(
       std::string_view path) const;
+
+  /// @brief Load shader and keep it for hot-reload.
+  /// @details Loading the same path again returns the current module.
+  /// @return Shared module; after a reload it is no longer the current one
+  [[nodiscard]] pandora::core::Result<
+      std::shared_ptr<const pandora::core::gpu::ShaderModule>>
+  loadWatched(std::string_view path);
+
+  /// @brief Get current module of a watched shader.
+  /// @return Module, or null if the path was not loaded with loadWatched()
+  std::shared_ptr<const pandora::core::gpu::ShaderModule> getWatched(
+      std::string_view path) const;
+
+  /// @brief Start watching the files of watched shaders.
+  /// @return Error if the file watch cannot be set up
+  [[nodiscard]] pandora::core::VoidResult startWatching();
+
+  /// @brief Stop the watch thread.
+  void stopWatching();
+
+  /// @brief Check whether the watch thread is running.
+  bool isWatching() const;
+
+  /// @brief Swap in modules recompiled since the last call.
+  /// @details Replaced modules, and the pipelines evicted from
+  /// pipeline_cache because they were built from them, are handed to the
+  /// context's deletion queue and destroyed once fence is signaled. Fetch the
+  /// dependent pipelines again afterwards to rebuild them.
+  /// @param fence Fence signaled by the last submission using the old objects
+  /// @param ptr_pipeline_cache Pipeline cache to evict from, or null
+  /// @return Paths whose modules were replaced
+  std::vector<std::string> applyReloads(
+      const pandora::core::gpu::Fence& fence,
+      PipelineCache* ptr_pipeline_cache = nullptr);
+
+  /// @brief Take errors of failed background recompiles.
+  /// @details A shader that fails to compile keeps its previous module.
+  std::vector<pandora::core::Error> takeReloadErrors();
 };
 
 }  // namespace pandora::highlevel
@@ -1,5 +1,18 @@
 #include "pandora/core/buffer_helpers.hpp"
 
+namespace {
+
+// Device-local memory that is also host-visible lets uploads skip staging
+pandora::core::MemoryUsage get_device_local_usage(
+    const pandora::core::gpu::Context& context) {
+  const auto& ptr_allocator = context.getPtrAllocator();
+  return ptr_allocator && ptr_allocator->isDirectWriteAvailable()
+             ? pandora::core::MemoryUsage::CpuToGpu
+             : pandora::core::MemoryUsage::GpuOnly;
+}
+
+}  // namespace
+
 namespace pandora::core {
 
 gpu::Buffer createStagingBufferToGPU(const gpu::Context& context, size_t size) {
@@ -43,7 +56,7 @@ gpu::Buffer createStorageBuffer(const gpu::Context& context,
                                 TransferType transfer_type,
                                 size_t size) {
   return gpu::Buffer(context,
-                     MemoryUsage::GpuOnly,
+                     get_device_local_usage(context),
                      transfer_type,
                      std::vector<BufferUsage>{BufferUsage::StorageBuffer},
                      size);
@@ -53,7 +66,7 @@ std::unique_ptr<gpu::Buffer> createUniqueStorageBuffer(
     const gpu::Context& context, TransferType transfer_type, size_t size) {
   return std::make_unique<gpu::Buffer>(
       context,
-      MemoryUsage::GpuOnly,
+      get_device_local_usage(context),
       transfer_type,
       std::vector<BufferUsage>{BufferUsage::StorageBuffer},
       size);
@@ -79,7 +92,7 @@ std::unique_ptr<gpu::Buffer> createUniqueUniformBuffer(
 
 gpu::Buffer createVertexBuffer(const gpu::Context& context, size_t size) {
   return gpu::Buffer(context,
-                     MemoryUsage::GpuOnly,
+                     get_device_local_usage(context),
                      TransferType::TransferDst,
                      std::vector<BufferUsage>{BufferUsage::VertexBuffer},
                      size);
@@ -89,7 +102,7 @@ std::unique_ptr<gpu::Buffer> createUniqueVertexBuffer(
     const gpu::Context& context, size_t size) {
   return std::make_unique<gpu::Buffer>(
       context,
-      MemoryUsage::GpuOnly,
+      get_device_local_usage(context),
       TransferType::TransferDst,
       std::vector<BufferUsage>{BufferUsage::VertexBuffer},
       size);
@@ -97,7 +110,7 @@ std::unique_ptr<gpu::Buffer> createUniqueVertexBuffer(
 
 gpu::Buffer createIndexBuffer(const gpu::Context& context, size_t size) {
   return gpu::Buffer(context,
-                     MemoryUsage::GpuOnly,
+                     get_device_local_usage(context),
                      TransferType::TransferDst,
                      std::vector<BufferUsage>{BufferUsage::IndexBuffer},
                      size);
@@ -107,7 +120,7 @@ std::unique_ptr<gpu::Buffer> createUniqueIndexBuffer(
     const gpu::Context& context, size_t size) {
   return std::make_unique<gpu::Buffer>(
       context,
-      MemoryUsage::GpuOnly,
+      get_device_local_usage(context),
       TransferType::TransferDst,
       std::vector<BufferUsage>{BufferUsage::IndexBuffer},
       size);
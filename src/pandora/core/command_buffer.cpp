@@ -1,8 +1,10 @@
 #include "pandora/core/command_buffer.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <ranges>
+#include <span>
 
 #include "pandora/core/gpu/vk_helper.hpp"
 #include "pandora/core/pipeline.hpp"
@@ -50,15 +52,74 @@ void CommandBuffer::bindDescriptorSet(
     const Pipeline& pipeline, const gpu::DescriptorSet& descriptor_set) const {
   m_commandBuffer.bindDescriptorSets(pipeline.getBindPoint(),
                                      pipeline.getPipelineLayout(),
-                                     0u,
+                                     descriptor_set.getSetIndex(),
+                                     descriptor_set.getDescriptorSet(),
+                                     {});
+}
+
+void CommandBuffer::bindDescriptorSet(
+    const Pipeline& pipeline,
+    const gpu::DescriptorSet& descriptor_set,
+    const std::vector<uint32_t>& dynamic_offsets) const {
+  m_commandBuffer.bindDescriptorSets(pipeline.getBindPoint(),
+                                     pipeline.getPipelineLayout(),
+                                     descriptor_set.getSetIndex(),
                                      descriptor_set.getDescriptorSet(),
+                                     dynamic_offsets);
+}
+
+void CommandBuffer::pushDescriptors(
+    const Pipeline& pipeline,
+    const std::vector<gpu::BufferDescription>& buffer_descriptions,
+    const std::vector<gpu::ImageDescription>& image_descriptions,
+    uint32_t set_index) const {
+  // Infos are collected first: the writes point into these vectors
+  const auto buffer_info_list =
+      buffer_descriptions
+      | std::views::transform([](const gpu::BufferDescription& desc) {
+          return desc.createVkBufferInfo();
+        })
+      | std::ranges::to<std::vector<vk::DescriptorBufferInfo>>();
+  const auto image_info_list =
+      image_descriptions
+      | std::views::transform([](const gpu::ImageDescription& desc) {
+          return desc.createVkImageInfo();
+        })
+      | std::ranges::to<std::vector<vk::DescriptorImageInfo>>();
+
+  std::vector<vk::WriteDescriptorSet> write_descriptor_sets;
+  write_descriptor_sets.reserve(buffer_info_list.size()
+                                + image_info_list.size());
+  for (const auto& [buffer_desc, buffer_info] :
+       std::views::zip(buffer_descriptions, buffer_info_list)) {
+    write_descriptor_sets.emplace_back(
+        buffer_desc.createVkWriteDescriptorSet(buffer_info));
+  }
+  for (const auto& [image_desc, image_info] :
+       std::views::zip(image_descriptions, image_info_list)) {
+    write_descriptor_sets.emplace_back(
+        image_desc.createVkWriteDescriptorSet(image_info));
+  }
+
+  m_commandBuffer.pushDescriptorSetKHR(pipeline.getBindPoint(),
+                                       pipeline.getPipelineLayout(),
+                                       set_index,
+                                       write_descriptor_sets);
+}
+
+void CommandBuffer::bindDescriptorSet(
+    const Pipeline& pipeline, const gpu::BindlessHeap& bindless_heap) const {
+  m_commandBuffer.bindDescriptorSets(pipeline.getBindPoint(),
+                                     pipeline.getPipelineLayout(),
+                                     0u,
+                                     bindless_heap.getDescriptorSet(),
                                      {});
 }
 
 void CommandBuffer::pushConstants(const Pipeline& pipeline,
                                   const std::vector<ShaderStage>& dst_stages,
                                   uint32_t offset,
-                                  const std::vector<float_t>& data) const {
+                                  std::span<const std::byte> data) const {
   m_commandBuffer.pushConstants(
       pipeline.getPipelineLayout(),
       std::ranges::fold_left(
@@ -66,10 +127,25 @@ void CommandBuffer::pushConstants(const Pipeline& pipeline,
           vk::ShaderStageFlags{},
           std::bit_or{}),
       offset,
-      static_cast<uint32_t>(sizeof(float_t) * data.size()),
+      static_cast<uint32_t>(data.size()),
       data.data());
 }
 
+void CommandBuffer::pushConstants(const Pipeline& pipeline,
+                                  const std::vector<ShaderStage>& dst_stages,
+                                  uint32_t offset,
+                                  const std::vector<float_t>& data) const {
+  pushConstants(pipeline, dst_stages, offset, std::as_bytes(std::span(data)));
+}
+
+void CommandBuffer::pushIndices(const Pipeline& pipeline,
+                                const std::vector<ShaderStage>& dst_stages,
+                                uint32_t offset,
+                                const std::vector<uint32_t>& indices) const {
+  pushConstants(
+      pipeline, dst_stages, offset, std::as_bytes(std::span(indices)));
+}
+
 void CommandBuffer::resetCommands() const {
   m_commandBuffer.reset(vk::CommandBufferResetFlags{});
 }
@@ -82,6 +158,29 @@ void TransferCommandBuffer::copyBuffer(const gpu::Buffer& staging_buffer,
       vk::BufferCopy{}.setSize(staging_buffer.getSize()));
 }
 
+void TransferCommandBuffer::copyBufferRegions(
+    const gpu::Buffer& src_buffer,
+    const gpu::Buffer& dst_buffer,
+    const std::vector<BufferCopyRegion>& regions) const {
+  if (regions.empty()) {
+    return;
+  }
+
+  const auto vk_regions = regions
+                          | std::views::transform([](const auto& region) {
+                              return vk::BufferCopy2{}
+                                  .setSrcOffset(region.src_offset)
+                                  .setDstOffset(region.dst_offset)
+                                  .setSize(region.size);
+                            })
+                          | std::ranges::to<std::vector>();
+
+  m_commandBuffer.copyBuffer2(vk::CopyBufferInfo2{}
+                                  .setSrcBuffer(src_buffer.getBuffer())
+                                  .setDstBuffer(dst_buffer.getBuffer())
+                                  .setRegions(vk_regions));
+}
+
 void TransferCommandBuffer::copyBufferToImage(
     const gpu::Buffer& buffer,
     const gpu::Image& image,
@@ -0,0 +1,556 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "pandora/core/gpu.hpp"
+
+namespace {
+
+constexpr vk::DeviceSize align_up(vk::DeviceSize value,
+                                  vk::DeviceSize alignment) {
+  return alignment > 1u ? (value + alignment - 1u) & ~(alignment - 1u)
+                        : value;
+}
+
+constexpr vk::DeviceSize align_down(vk::DeviceSize value,
+                                    vk::DeviceSize alignment) {
+  return alignment > 1u ? value & ~(alignment - 1u) : value;
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+MemoryBlockMetadata::MemoryBlockMetadata(vk::DeviceSize size)
+    : m_size(size), m_freeSize(size) {
+  if (size > 0u) {
+    m_freeRanges.emplace(0u, size);
+  }
+}
+
+std::optional<vk::DeviceSize> MemoryBlockMetadata::allocate(
+    vk::DeviceSize size, vk::DeviceSize alignment) {
+  if (size == 0u || size > m_freeSize) {
+    return std::nullopt;
+  }
+
+  for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it) {
+    const auto [range_offset, range_size] = *it;
+    const auto aligned_offset = align_up(range_offset, alignment);
+    const auto range_end = range_offset + range_size;
+
+    if (aligned_offset + size > range_end) {
+      continue;
+    }
+
+    // Split the free range into [padding][allocation][tail]
+    m_freeRanges.erase(it);
+    if (aligned_offset > range_offset) {
+      m_freeRanges.emplace(range_offset, aligned_offset - range_offset);
+    }
+    if (aligned_offset + size < range_end) {
+      m_freeRanges.emplace(aligned_offset + size,
+                           range_end - (aligned_offset + size));
+    }
+
+    m_freeSize -= size;
+    return aligned_offset;
+  }
+
+  return std::nullopt;
+}
+
+void MemoryBlockMetadata::free(vk::DeviceSize offset, vk::DeviceSize size) {
+  if (size == 0u) {
+    return;
+  }
+
+  auto [it, inserted] = m_freeRanges.emplace(offset, size);
+  if (!inserted) {
+    return;
+  }
+  m_freeSize += size;
+
+  // Merge with the following range
+  if (const auto next = std::next(it);
+      next != m_freeRanges.end() && it->first + it->second == next->first) {
+    it->second += next->second;
+    m_freeRanges.erase(next);
+  }
+
+  // Merge with the preceding range
+  if (it != m_freeRanges.begin()) {
+    const auto prev = std::prev(it);
+    if (prev->first + prev->second == it->first) {
+      prev->second += it->second;
+      m_freeRanges.erase(it);
+    }
+  }
+}
+
+MemoryAllocation::~MemoryAllocation() {
+  release();
+}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept
+    : m_ptrAllocator(std::exchange(other.m_ptrAllocator, nullptr)),
+      m_ptrBlock(std::exchange(other.m_ptrBlock, nullptr)),
+      m_offset(std::exchange(other.m_offset, 0u)),
+      m_size(std::exchange(other.m_size, 0u)),
+      m_ptrPersistentMapping(
+          std::exchange(other.m_ptrPersistentMapping, nullptr)) {}
+
+MemoryAllocation& MemoryAllocation::operator=(
+    MemoryAllocation&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_ptrAllocator = std::exchange(other.m_ptrAllocator, nullptr);
+    m_ptrBlock = std::exchange(other.m_ptrBlock, nullptr);
+    m_offset = std::exchange(other.m_offset, 0u);
+    m_size = std::exchange(other.m_size, 0u);
+    m_ptrPersistentMapping =
+        std::exchange(other.m_ptrPersistentMapping, nullptr);
+  }
+  return *this;
+}
+
+void* MemoryAllocation::map() const {
+  if (!m_ptrAllocator || !m_ptrBlock) {
+    return nullptr;
+  }
+  return m_ptrAllocator->map(m_ptrBlock, m_offset);
+}
+
+void MemoryAllocation::unmap() const {
+  if (m_ptrAllocator && m_ptrBlock) {
+    m_ptrAllocator->unmap(m_ptrBlock);
+  }
+}
+
+void* MemoryAllocation::mapPersistently() {
+  if (!m_ptrPersistentMapping) {
+    m_ptrPersistentMapping = map();
+  }
+  return m_ptrPersistentMapping;
+}
+
+bool MemoryAllocation::isHostCoherent() const {
+  return m_ptrAllocator && m_ptrBlock
+         && m_ptrAllocator->isHostCoherent(m_ptrBlock);
+}
+
+void MemoryAllocation::flush(vk::DeviceSize offset,
+                             vk::DeviceSize size) const {
+  if (!m_ptrAllocator || !m_ptrBlock || isHostCoherent()) {
+    return;
+  }
+
+  const auto range_size = size == VK_WHOLE_SIZE ? m_size - offset : size;
+  m_ptrAllocator->m_device.flushMappedMemoryRanges(
+      m_ptrAllocator->getMappedMemoryRange(
+          m_ptrBlock, m_offset + offset, range_size));
+}
+
+void MemoryAllocation::invalidate(vk::DeviceSize offset,
+                                  vk::DeviceSize size) const {
+  if (!m_ptrAllocator || !m_ptrBlock || isHostCoherent()) {
+    return;
+  }
+
+  const auto range_size = size == VK_WHOLE_SIZE ? m_size - offset : size;
+  m_ptrAllocator->m_device.invalidateMappedMemoryRanges(
+      m_ptrAllocator->getMappedMemoryRange(
+          m_ptrBlock, m_offset + offset, range_size));
+}
+
+void MemoryAllocation::release() {
+  if (m_ptrAllocator && m_ptrBlock) {
+    if (m_ptrPersistentMapping) {
+      m_ptrAllocator->unmap(m_ptrBlock);
+    }
+    m_ptrAllocator->free(m_ptrBlock, m_offset, m_size);
+  }
+  m_ptrAllocator = nullptr;
+  m_ptrBlock = nullptr;
+  m_offset = 0u;
+  m_size = 0u;
+  m_ptrPersistentMapping = nullptr;
+}
+
+MemoryAllocator::MemoryAllocator(const Device& device,
+                                 vk::DeviceSize preferred_block_size)
+    : m_device(device.getPtrLogicalDevice().get()),
+      m_preferredBlockSize(preferred_block_size) {
+  m_memoryProperties = device.getMemoryProperties();
+  const auto& limits = device.getLimits();
+  m_bufferImageGranularity = limits.bufferImageGranularity;
+  m_nonCoherentAtomSize = limits.nonCoherentAtomSize;
+
+  // Device-local memory counts as directly writable only if the largest
+  // device-local heap is host-visible, not just a small BAR window
+  std::optional<uint32_t> main_heap_idx;
+  for (uint32_t heap_idx = 0u; heap_idx < m_memoryProperties.memoryHeapCount;
+       heap_idx += 1u) {
+    const auto& heap = m_memoryProperties.memoryHeaps.at(heap_idx);
+    if ((heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal)
+        && (!main_heap_idx.has_value()
+            || heap.size
+                   > m_memoryProperties.memoryHeaps.at(main_heap_idx.value())
+                         .size)) {
+      main_heap_idx = heap_idx;
+    }
+  }
+  constexpr auto direct_write_flags =
+      vk::MemoryPropertyFlagBits::eDeviceLocal
+      | vk::MemoryPropertyFlagBits::eHostVisible;
+  for (uint32_t memory_type_idx = 0u;
+       memory_type_idx < m_memoryProperties.memoryTypeCount;
+       memory_type_idx += 1u) {
+    const auto& memory_type =
+        m_memoryProperties.memoryTypes.at(memory_type_idx);
+    if ((memory_type.propertyFlags & direct_write_flags) == direct_write_flags
+        && memory_type.heapIndex == main_heap_idx) {
+      m_hasHostVisibleDeviceLocal = true;
+    }
+  }
+
+  // One pool per (memory type, resource kind)
+  m_pools.resize(static_cast<size_t>(m_memoryProperties.memoryTypeCount) * 2u);
+}
+
+MemoryAllocator::~MemoryAllocator() {
+  // Allocations still alive at this point would dangle; the memory objects are
+  // released together with the blocks.
+  m_dedicatedBlocks.clear();
+  m_pools.clear();
+}
+
+MemoryAllocation MemoryAllocator::allocateForBuffer(
+    vk::Buffer buffer,
+    const MemoryTypeRequest& request,
+    AllocationStrategy strategy) {
+  const auto requirements_chain = m_device.getBufferMemoryRequirements2<
+      vk::MemoryRequirements2,
+      vk::MemoryDedicatedRequirements>(
+      vk::BufferMemoryRequirementsInfo2{}.setBuffer(buffer));
+  const auto& requirements =
+      requirements_chain.get<vk::MemoryRequirements2>().memoryRequirements;
+  const auto& dedicated_requirements =
+      requirements_chain.get<vk::MemoryDedicatedRequirements>();
+
+  const bool use_dedicated =
+      strategy == AllocationStrategy::Dedicated
+      || dedicated_requirements.requiresDedicatedAllocation
+      || dedicated_requirements.prefersDedicatedAllocation;
+
+  return allocate(requirements,
+                  request,
+                  AllocationKind::Linear,
+                  use_dedicated,
+                  vk::MemoryDedicatedAllocateInfo{}.setBuffer(buffer));
+}
+
+MemoryAllocation MemoryAllocator::allocateForImage(
+    vk::Image image,
+    const MemoryTypeRequest& request,
+    AllocationStrategy strategy) {
+  const auto requirements_chain = m_device.getImageMemoryRequirements2<
+      vk::MemoryRequirements2,
+      vk::MemoryDedicatedRequirements>(
+      vk::ImageMemoryRequirementsInfo2{}.setImage(image));
+  const auto& requirements =
+      requirements_chain.get<vk::MemoryRequirements2>().memoryRequirements;
+  const auto& dedicated_requirements =
+      requirements_chain.get<vk::MemoryDedicatedRequirements>();
+
+  const bool use_dedicated =
+      strategy == AllocationStrategy::Dedicated
+      || dedicated_requirements.requiresDedicatedAllocation
+      || dedicated_requirements.prefersDedicatedAllocation;
+
+  return allocate(requirements,
+                  request,
+                  AllocationKind::Optimal,
+                  use_dedicated,
+                  vk::MemoryDedicatedAllocateInfo{}.setImage(image));
+}
+
+size_t MemoryAllocator::getDeviceMemoryCount() const {
+  std::lock_guard lock(m_mutex);
+
+  size_t count = m_dedicatedBlocks.size();
+  for (const auto& pool : m_pools) {
+    count += pool.size();
+  }
+  return count;
+}
+
+std::vector<uint32_t> MemoryAllocator::rankMemoryTypes(
+    uint32_t memory_type_bits, const MemoryTypeRequest& request) const {
+  const auto count_flags = [](vk::MemoryPropertyFlags flags) {
+    return std::popcount(static_cast<uint32_t>(flags));
+  };
+
+  std::vector<std::pair<int32_t, uint32_t>> scored_types;
+  for (uint32_t memory_type_idx = 0u;
+       memory_type_idx < m_memoryProperties.memoryTypeCount;
+       memory_type_idx += 1u) {
+    const auto property_flags =
+        m_memoryProperties.memoryTypes.at(memory_type_idx).propertyFlags;
+    if (!(memory_type_bits & (1u << memory_type_idx))
+        || (property_flags & request.required) != request.required) {
+      continue;
+    }
+
+    const auto score = count_flags(property_flags & request.preferred)
+                       - count_flags(property_flags & request.avoided);
+    scored_types.emplace_back(score, memory_type_idx);
+  }
+
+  // Higher score first; equal scores keep the driver's type order
+  std::ranges::stable_sort(scored_types, std::greater{}, [](const auto& entry) {
+    return entry.first;
+  });
+
+  std::vector<uint32_t> memory_type_indices;
+  memory_type_indices.reserve(scored_types.size());
+  for (const auto& [score, memory_type_idx] : scored_types) {
+    memory_type_indices.push_back(memory_type_idx);
+  }
+  return memory_type_indices;
+}
+
+void MemoryAllocator::collectStats(MemoryStats& stats) const {
+  std::lock_guard lock(m_mutex);
+
+  stats.heaps.clear();
+  for (uint32_t heap_idx = 0u; heap_idx < m_memoryProperties.memoryHeapCount;
+       heap_idx += 1u) {
+    const auto& heap = m_memoryProperties.memoryHeaps.at(heap_idx);
+    stats.heaps.push_back(HeapStats{
+        .heap_index = heap_idx,
+        .heap_size = heap.size,
+        .is_device_local = static_cast<bool>(
+            heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal),
+    });
+  }
+
+  const auto add_block = [&](const MemoryBlock& block) {
+    const auto heap_idx =
+        m_memoryProperties.memoryTypes.at(block.memory_type_index).heapIndex;
+    auto& heap_stats = stats.heaps.at(heap_idx);
+    heap_stats.allocated_bytes += block.metadata.getSize();
+    heap_stats.used_bytes +=
+        block.metadata.getSize() - block.metadata.getFreeSize();
+  };
+
+  stats.device_memory_count = m_dedicatedBlocks.size();
+  for (const auto& ptr_block : m_dedicatedBlocks) {
+    add_block(*ptr_block);
+  }
+  for (const auto& pool : m_pools) {
+    stats.device_memory_count += pool.size();
+    for (const auto& ptr_block : pool) {
+      add_block(*ptr_block);
+    }
+  }
+
+  stats.total_allocation_count = m_allocationCount;
+  stats.total_free_count = m_freeCount;
+  stats.frame_allocation_count = m_lastFrameAllocationCount;
+  stats.frame_free_count = m_lastFrameFreeCount;
+}
+
+void MemoryAllocator::markFrame() {
+  std::lock_guard lock(m_mutex);
+
+  m_lastFrameAllocationCount = m_allocationCount - m_frameStartAllocationCount;
+  m_lastFrameFreeCount = m_freeCount - m_frameStartFreeCount;
+  m_frameStartAllocationCount = m_allocationCount;
+  m_frameStartFreeCount = m_freeCount;
+}
+
+MemoryAllocation MemoryAllocator::allocate(
+    const vk::MemoryRequirements& requirements,
+    const MemoryTypeRequest& request,
+    AllocationKind kind,
+    bool use_dedicated,
+    const vk::MemoryDedicatedAllocateInfo& dedicated) {
+  const auto memory_type_indices =
+      rankMemoryTypes(requirements.memoryTypeBits, request);
+  if (memory_type_indices.empty()) {
+    throw vk::OutOfDeviceMemoryError(
+        "MemoryAllocator: no memory type satisfies the required properties");
+  }
+
+  // A full heap is not fatal while a lower-ranked type can still serve
+  for (size_t rank = 0u;; rank += 1u) {
+    try {
+      return allocateFromType(memory_type_indices.at(rank),
+                              requirements,
+                              kind,
+                              use_dedicated,
+                              dedicated);
+    } catch (const vk::OutOfDeviceMemoryError&) {
+      if (rank + 1u == memory_type_indices.size()) {
+        throw;
+      }
+    }
+  }
+}
+
+MemoryAllocation MemoryAllocator::allocateFromType(
+    uint32_t memory_type_idx,
+    const vk::MemoryRequirements& requirements,
+    AllocationKind kind,
+    bool use_dedicated,
+    const vk::MemoryDedicatedAllocateInfo& dedicated) {
+  const auto block_size = getBlockSize(memory_type_idx);
+
+  std::lock_guard lock(m_mutex);
+
+  // Very large resources would waste most of a block; give them their own
+  // memory object.
+  if (use_dedicated || requirements.size > block_size / 2u) {
+    auto ptr_block = std::make_unique<MemoryBlock>(MemoryBlock{
+        .ptr_memory = m_device.allocateMemoryUnique(
+            vk::MemoryAllocateInfo{}
+                .setMemoryTypeIndex(memory_type_idx)
+                .setAllocationSize(requirements.size)
+                .setPNext(use_dedicated ? &dedicated : nullptr)),
+        .metadata = MemoryBlockMetadata(requirements.size),
+        .memory_type_index = memory_type_idx,
+        .kind = kind,
+        .is_dedicated = true,
+    });
+    ptr_block->metadata.allocate(requirements.size, 1u);
+
+    auto* block = ptr_block.get();
+    m_dedicatedBlocks.emplace_back(std::move(ptr_block));
+    m_allocationCount += 1u;
+    return MemoryAllocation(this, block, 0u, requirements.size);
+  }
+
+  // Linear and optimal resources only need separate blocks when the device
+  // has a page granularity that they must not share.
+  const auto pool_kind =
+      m_bufferImageGranularity > 1u ? kind : AllocationKind::Linear;
+  auto& pool = m_pools.at(static_cast<size_t>(memory_type_idx) * 2u
+                          + static_cast<size_t>(pool_kind));
+
+  for (const auto& ptr_block : pool) {
+    if (const auto offset = ptr_block->metadata.allocate(
+            requirements.size, requirements.alignment)) {
+      m_allocationCount += 1u;
+      return MemoryAllocation(
+          this, ptr_block.get(), offset.value(), requirements.size);
+    }
+  }
+
+  auto ptr_block = std::make_unique<MemoryBlock>(MemoryBlock{
+      .ptr_memory = m_device.allocateMemoryUnique(
+          vk::MemoryAllocateInfo{}
+              .setMemoryTypeIndex(memory_type_idx)
+              .setAllocationSize(block_size)),
+      .metadata = MemoryBlockMetadata(block_size),
+      .memory_type_index = memory_type_idx,
+      .kind = pool_kind,
+  });
+  const auto offset =
+      ptr_block->metadata.allocate(requirements.size, requirements.alignment);
+
+  auto* block = ptr_block.get();
+  pool.emplace_back(std::move(ptr_block));
+  m_allocationCount += 1u;
+  return MemoryAllocation(this, block, offset.value(), requirements.size);
+}
+
+vk::DeviceSize MemoryAllocator::getBlockSize(uint32_t memory_type_idx) const {
+  const auto heap_idx =
+      m_memoryProperties.memoryTypes.at(memory_type_idx).heapIndex;
+  const auto heap_size = m_memoryProperties.memoryHeaps.at(heap_idx).size;
+
+  // Small heaps (e.g. the 256MB BAR window) must not be consumed by one block
+  return std::min(m_preferredBlockSize, align_up(heap_size / 8u, 1024u));
+}
+
+void MemoryAllocator::free(MemoryBlock* block,
+                           vk::DeviceSize offset,
+                           vk::DeviceSize size) {
+  std::lock_guard lock(m_mutex);
+  m_freeCount += 1u;
+
+  if (block->is_dedicated) {
+    std::erase_if(m_dedicatedBlocks,
+                  [block](const auto& ptr) { return ptr.get() == block; });
+    return;
+  }
+
+  block->metadata.free(offset, size);
+  if (!block->metadata.isEmpty()) {
+    return;
+  }
+
+  // Keep one empty block per pool to avoid allocation churn
+  auto& pool = m_pools.at(static_cast<size_t>(block->memory_type_index) * 2u
+                          + static_cast<size_t>(block->kind));
+  const auto empty_count = std::ranges::count_if(
+      pool, [](const auto& ptr) { return ptr->metadata.isEmpty(); });
+  if (empty_count > 1) {
+    std::erase_if(pool,
+                  [block](const auto& ptr) { return ptr.get() == block; });
+  }
+}
+
+void* MemoryAllocator::map(MemoryBlock* block, vk::DeviceSize offset) {
+  std::lock_guard lock(m_mutex);
+
+  if (block->map_count == 0u) {
+    block->ptr_mapped = m_device.mapMemory(
+        block->ptr_memory.get(), 0u, VK_WHOLE_SIZE, {});
+  }
+  block->map_count += 1u;
+
+  return static_cast<std::byte*>(block->ptr_mapped) + offset;
+}
+
+void MemoryAllocator::unmap(MemoryBlock* block) {
+  std::lock_guard lock(m_mutex);
+
+  if (block->map_count == 0u) {
+    return;
+  }
+
+  block->map_count -= 1u;
+  if (block->map_count == 0u) {
+    m_device.unmapMemory(block->ptr_memory.get());
+    block->ptr_mapped = nullptr;
+  }
+}
+
+bool MemoryAllocator::isHostCoherent(const MemoryBlock* block) const {
+  return static_cast<bool>(
+      m_memoryProperties.memoryTypes.at(block->memory_type_index).propertyFlags
+      & vk::MemoryPropertyFlagBits::eHostCoherent);
+}
+
+vk::MappedMemoryRange MemoryAllocator::getMappedMemoryRange(
+    const MemoryBlock* block,
+    vk::DeviceSize offset,
+    vk::DeviceSize size) const {
+  // Both ends must sit on nonCoherentAtomSize, or the end must be the end of
+  // the memory object.
+  const auto block_size = block->metadata.getSize();
+  const auto begin = align_down(offset, m_nonCoherentAtomSize);
+  const auto end =
+      std::min(align_up(offset + size, m_nonCoherentAtomSize), block_size);
+
+  return vk::MappedMemoryRange{}
+      .setMemory(block->ptr_memory.get())
+      .setOffset(begin)
+      .setSize(end - begin);
+}
+
+}  // namespace pandora::core::gpu
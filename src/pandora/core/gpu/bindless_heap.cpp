@@ -0,0 +1,216 @@
+#include "pandora/core/gpu/bindless_heap.hpp"
+
+#include <algorithm>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/gpu/vk_helper.hpp"
+
+namespace {
+
+vk::DescriptorType get_descriptor_type(
+    pandora::core::gpu::BindlessResource kind) {
+  switch (kind) {
+    using enum pandora::core::gpu::BindlessResource;
+    case SampledImage:
+      return vk::DescriptorType::eCombinedImageSampler;
+    case StorageImage:
+      return vk::DescriptorType::eStorageImage;
+    case StorageBuffer:
+      return vk::DescriptorType::eStorageBuffer;
+    default:
+      return vk::DescriptorType::eCombinedImageSampler;
+  }
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+BindlessHeap::BindlessHeap(const Context& context,
+                           uint32_t max_sampled_images,
+                           uint32_t max_storage_images,
+                           uint32_t max_storage_buffers)
+    : m_device(context.getPtrDevice()->getPtrLogicalDevice().get()) {
+  if (!context.getPtrDevice()->hasDescriptorIndexing()) {
+    throw vk::FeatureNotPresentError(
+        "BindlessHeap requires Vulkan 1.2 descriptor indexing");
+  }
+
+  {
+    const auto properties_chain =
+        context.getPtrDevice()
+            ->getPhysicalDevice()
+            .getProperties2<vk::PhysicalDeviceProperties2,
+                            vk::PhysicalDeviceVulkan12Properties>();
+    const auto& v12_properties =
+        properties_chain.get<vk::PhysicalDeviceVulkan12Properties>();
+
+    m_slots.at(static_cast<size_t>(BindlessResource::SampledImage)).capacity =
+        std::min(
+            {max_sampled_images,
+             v12_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+             v12_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+             v12_properties.maxDescriptorSetUpdateAfterBindSamplers,
+             v12_properties.maxPerStageDescriptorUpdateAfterBindSamplers});
+    m_slots.at(static_cast<size_t>(BindlessResource::StorageImage)).capacity =
+        std::min(
+            {max_storage_images,
+             v12_properties.maxDescriptorSetUpdateAfterBindStorageImages,
+             v12_properties.maxPerStageDescriptorUpdateAfterBindStorageImages});
+    m_slots.at(static_cast<size_t>(BindlessResource::StorageBuffer)).capacity =
+        std::min(
+            {max_storage_buffers,
+             v12_properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+             v12_properties
+                 .maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+  }
+
+  std::vector<vk::DescriptorSetLayoutBinding> bindings;
+  std::vector<vk::DescriptorBindingFlags> binding_flags;
+  std::vector<vk::DescriptorPoolSize> pool_sizes;
+  for (const auto kind : {BindlessResource::SampledImage,
+                          BindlessResource::StorageImage,
+                          BindlessResource::StorageBuffer}) {
+    const auto capacity = getCapacity(kind);
+    const auto descriptor_type = get_descriptor_type(kind);
+
+    bindings.push_back(vk::DescriptorSetLayoutBinding{}
+                           .setBinding(static_cast<uint32_t>(kind))
+                           .setDescriptorType(descriptor_type)
+                           .setDescriptorCount(capacity)
+                           .setStageFlags(vk::ShaderStageFlagBits::eAll));
+    binding_flags.push_back(vk::DescriptorBindingFlagBits::ePartiallyBound
+                            | vk::DescriptorBindingFlagBits::eUpdateAfterBind
+                            | vk::DescriptorBindingFlagBits::
+                                eUpdateUnusedWhilePending);
+    pool_sizes.emplace_back(descriptor_type, capacity);
+  }
+
+  const auto binding_flags_info =
+      vk::DescriptorSetLayoutBindingFlagsCreateInfo{}.setBindingFlags(
+          binding_flags);
+  m_ptrDescriptorSetLayout = m_device.createDescriptorSetLayoutUnique(
+      vk::DescriptorSetLayoutCreateInfo{}
+          .setFlags(
+              vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool)
+          .setBindings(bindings)
+          .setPNext(&binding_flags_info));
+
+  m_ptrDescriptorPool = m_device.createDescriptorPoolUnique(
+      vk::DescriptorPoolCreateInfo{}
+          .setFlags(vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind)
+          .setMaxSets(1u)
+          .setPoolSizes(pool_sizes));
+
+  m_descriptorSet = m_device
+                        .allocateDescriptorSets(
+                            vk::DescriptorSetAllocateInfo{}
+                                .setDescriptorPool(m_ptrDescriptorPool.get())
+                                .setSetLayouts(m_ptrDescriptorSetLayout.get()))
+                        .front();
+}
+
+BindlessHeap::~BindlessHeap() = default;
+
+Result<uint32_t> BindlessHeap::registerSampledImage(
+    const ImageView& image_view,
+    const Sampler& sampler,
+    ImageLayout image_layout) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PANDORA_TRY_ASSIGN(index, acquireIndex(BindlessResource::SampledImage));
+
+  const auto image_info =
+      vk::DescriptorImageInfo{}
+          .setImageView(image_view.getImageView())
+          .setSampler(sampler.getSampler())
+          .setImageLayout(vk_helper::getImageLayout(image_layout));
+  m_device.updateDescriptorSets(
+      vk::WriteDescriptorSet{}
+          .setDstSet(m_descriptorSet)
+          .setDstBinding(static_cast<uint32_t>(BindlessResource::SampledImage))
+          .setDstArrayElement(index)
+          .setDescriptorType(vk::DescriptorType::eCombinedImageSampler)
+          .setImageInfo(image_info),
+      nullptr);
+
+  return index;
+}
+
+Result<uint32_t> BindlessHeap::registerStorageImage(
+    const ImageView& image_view) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PANDORA_TRY_ASSIGN(index, acquireIndex(BindlessResource::StorageImage));
+
+  const auto image_info = vk::DescriptorImageInfo{}
+                              .setImageView(image_view.getImageView())
+                              .setImageLayout(vk::ImageLayout::eGeneral);
+  m_device.updateDescriptorSets(
+      vk::WriteDescriptorSet{}
+          .setDstSet(m_descriptorSet)
+          .setDstBinding(static_cast<uint32_t>(BindlessResource::StorageImage))
+          .setDstArrayElement(index)
+          .setDescriptorType(vk::DescriptorType::eStorageImage)
+          .setImageInfo(image_info),
+      nullptr);
+
+  return index;
+}
+
+Result<uint32_t> BindlessHeap::registerStorageBuffer(const Buffer& buffer,
+                                                     vk::DeviceSize offset,
+                                                     vk::DeviceSize range) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PANDORA_TRY_ASSIGN(index, acquireIndex(BindlessResource::StorageBuffer));
+
+  const auto buffer_info = vk::DescriptorBufferInfo{}
+                               .setBuffer(buffer.getBuffer())
+                               .setOffset(offset)
+                               .setRange(range);
+  m_device.updateDescriptorSets(
+      vk::WriteDescriptorSet{}
+          .setDstSet(m_descriptorSet)
+          .setDstBinding(static_cast<uint32_t>(BindlessResource::StorageBuffer))
+          .setDstArrayElement(index)
+          .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+          .setBufferInfo(buffer_info),
+      nullptr);
+
+  return index;
+}
+
+void BindlessHeap::release(BindlessResource kind, uint32_t index) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto& slots = m_slots.at(static_cast<size_t>(kind));
+  if (index < slots.next_index) {
+    slots.free_indices.push_back(index);
+  }
+}
+
+uint32_t BindlessHeap::getRegisteredCount(BindlessResource kind) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto& slots = m_slots.at(static_cast<size_t>(kind));
+  return slots.next_index - static_cast<uint32_t>(slots.free_indices.size());
+}
+
+Result<uint32_t> BindlessHeap::acquireIndex(BindlessResource kind) {
+  auto& slots = m_slots.at(static_cast<size_t>(kind));
+
+  if (!slots.free_indices.empty()) {
+    const auto index = slots.free_indices.back();
+    slots.free_indices.pop_back();
+    return index;
+  }
+  if (slots.next_index < slots.capacity) {
+    return slots.next_index++;
+  }
+
+  return Error::runtime("Bindless descriptor array is full")
+      .withContext("BindlessHeap::acquireIndex");
+}
+
+}  // namespace pandora::core::gpu
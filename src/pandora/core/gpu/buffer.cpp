@@ -53,7 +53,8 @@ Buffer::Buffer(const Context& context,
                MemoryUsage memory_usage,
                TransferType transfer_type,
                const std::vector<BufferUsage>& buffer_usages,
-               size_t size)
+               size_t size,
+               AllocationStrategy allocation_strategy)
     : m_size(size) {
   const auto& ptr_vk_device = context.getPtrDevice()->getPtrLogicalDevice();
 
@@ -71,43 +72,39 @@ Buffer::Buffer(const Context& context,
             .setSharingMode(vk::SharingMode::eExclusive));
   }
 
-  {
-    const auto memory_requirements =
-        ptr_vk_device->getBufferMemoryRequirements(m_ptrBuffer.get());
-    const auto vk_memory_usage =
-        vk_helper::getMemoryPropertyFlags(memory_usage);
-    const auto memory_props =
-        context.getPtrDevice()->getPhysicalDevice().getMemoryProperties();
-
-    uint32_t memory_type_idx = 0u;
-    for (; memory_type_idx < memory_props.memoryTypeCount;
-         memory_type_idx += 1u) {
-      if ((memory_requirements.memoryTypeBits & (1 << memory_type_idx))
-          && (memory_props.memoryTypes.at(memory_type_idx).propertyFlags
-              & vk_memory_usage)
-                 == vk_memory_usage) {
-        break;
-      }
-    }
-
-    m_ptrMemory = ptr_vk_device->allocateMemoryUnique(
-        vk::MemoryAllocateInfo{}
-            .setMemoryTypeIndex(memory_type_idx)
-            .setAllocationSize(memory_requirements.size));
+  const auto memory_type_request =
+      vk_helper::getMemoryTypeRequest(memory_usage);
+  m_memoryAllocation = context.getPtrAllocator()->allocateForBuffer(
+      m_ptrBuffer.get(), memory_type_request, allocation_strategy);
+
+  ptr_vk_device->bindBufferMemory(m_ptrBuffer.get(),
+                                  m_memoryAllocation.getMemory(),
+                                  m_memoryAllocation.getOffset());
+
+  // Host-visible buffers keep one mapping for their whole lifetime
+  if (memory_type_request.required
+      & vk::MemoryPropertyFlagBits::eHostVisible) {
+    m_memoryAllocation.mapPersistently();
   }
 
-  ptr_vk_device->bindBufferMemory(m_ptrBuffer.get(), m_ptrMemory.get(), 0u);
+  m_trackingToken = TrackedResourceToken(
+      context.getPtrResourceTracker().get(), TrackedResource::Buffer);
 }
 
 Buffer::~Buffer() = default;
 
-void* Buffer::mapMemory(const Context& context) const {
-  return context.getPtrDevice()->getPtrLogicalDevice()->mapMemory(
-      m_ptrMemory.get(), 0u, m_size, {});
+void* Buffer::mapMemory(const Context&) const {
+  if (isPersistentlyMapped()) {
+    return m_memoryAllocation.getPersistentMapping();
+  }
+  return m_memoryAllocation.map();
 }
 
-void Buffer::unmapMemory(const Context& context) const {
-  context.getPtrDevice()->getPtrLogicalDevice()->unmapMemory(m_ptrMemory.get());
+void Buffer::unmapMemory(const Context&) const {
+  if (isPersistentlyMapped()) {
+    return;
+  }
+  m_memoryAllocation.unmap();
 }
 
 }  // namespace pandora::core::gpu
@@ -7,7 +7,8 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
 namespace pandora::core::gpu {
 
-Context::Context(std::shared_ptr<gpu_ui::WindowSurface> window_surface) {
+Context::Context(std::shared_ptr<gpu_ui::WindowSurface> window_surface,
+                 std::filesystem::path pipeline_cache_path) {
   // Helpers to manage instance extensions
   auto get_available_instance_extensions = []() {
     std::unordered_set<std::string> names;
@@ -112,6 +113,18 @@ Context::Context(std::shared_ptr<gpu_ui::WindowSurface> window_surface) {
   }
 
   m_isInitialized = m_ptrDevice && m_ptrDevice->getPtrLogicalDevice();
+
+  if (m_isInitialized) {
+    m_ptrAllocator = std::make_unique<MemoryAllocator>(*m_ptrDevice);
+    m_ptrDeletionQueue = std::make_unique<DeletionQueue>(*m_ptrDevice);
+    m_ptrResourceTracker = std::make_unique<ResourceTracker>();
+    m_ptrDescriptorAllocator = std::make_unique<DescriptorAllocator>(*this);
+    m_ptrLayoutCache = std::make_unique<LayoutCache>(*m_ptrDevice);
+    m_ptrSamplerCache = std::make_unique<SamplerCache>(*m_ptrDevice);
+    m_ptrImageViewCache = std::make_unique<ImageViewCache>(*m_ptrDevice);
+    m_ptrPipelineCacheStore = std::make_unique<PipelineCacheStore>(
+        *m_ptrDevice, std::move(pipeline_cache_path));
+  }
 }
 
 Context::~Context() {
@@ -120,7 +133,21 @@ Context::~Context() {
     m_ptrDevice->waitIdle();
   }
 
+  // Persist compiled pipelines for the next start; failure only costs time
+  if (m_ptrPipelineCacheStore) {
+    static_cast<void>(m_ptrPipelineCacheStore->save());
+    m_ptrPipelineCacheStore.reset();
+  }
+
+  // Deferred resources still hold allocations, so drop them first
+  m_ptrDeletionQueue.reset();
+  m_ptrDescriptorAllocator.reset();
+  m_ptrLayoutCache.reset();
+  m_ptrSamplerCache.reset();
+  m_ptrImageViewCache.reset();
   m_ptrSwapchain.reset();
+  m_ptrAllocator.reset();
+  m_ptrResourceTracker.reset();
   m_ptrDevice.reset();
 
   if (m_ptrWindowSurface) {
@@ -142,4 +169,33 @@ void Context::resetSwapchain() {
   m_ptrSwapchain->resetSwapchain(*m_ptrDevice, m_ptrWindowSurface);
 }
 
+MemoryStats Context::memoryStats() const {
+  MemoryStats stats{};
+  if (!m_isInitialized) {
+    return stats;
+  }
+
+  m_ptrAllocator->collectStats(stats);
+  stats.live_resources = m_ptrResourceTracker->getLiveCounts();
+  stats.has_memory_budget = m_ptrDevice->hasMemoryBudget();
+
+  if (stats.has_memory_budget) {
+    using BudgetProperties = vk::PhysicalDeviceMemoryBudgetPropertiesEXT;
+    const auto properties_chain =
+        m_ptrDevice->getPhysicalDevice()
+            .getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2,
+                                  BudgetProperties>();
+    const auto& budget_properties = properties_chain.get<BudgetProperties>();
+
+    for (auto& heap_stats : stats.heaps) {
+      heap_stats.budget_bytes =
+          budget_properties.heapBudget.at(heap_stats.heap_index);
+      heap_stats.process_usage_bytes =
+          budget_properties.heapUsage.at(heap_stats.heap_index);
+    }
+  }
+
+  return stats;
+}
+
 }  // namespace pandora::core::gpu
@@ -0,0 +1,71 @@
+#include "pandora/core/gpu/deletion_queue.hpp"
+
+#include <algorithm>
+
+#include "pandora/core/gpu.hpp"
+
+namespace pandora::core::gpu {
+
+DeletionQueue::DeletionQueue(const Device& device)
+    : m_device(device.getPtrLogicalDevice().get()) {}
+
+DeletionQueue::~DeletionQueue() {
+  flush();
+}
+
+size_t DeletionQueue::collect() {
+  std::vector<Entry> reached_entries;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto first_reached = std::stable_partition(
+        m_entries.begin(), m_entries.end(), [this](const Entry& entry) {
+          return !isReached(entry);
+        });
+    reached_entries.assign(std::make_move_iterator(first_reached),
+                           std::make_move_iterator(m_entries.end()));
+    m_entries.erase(first_reached, m_entries.end());
+  }
+
+  // Resources are destroyed outside the lock: their destructors may return
+  // memory to the allocator, which takes its own lock.
+  return reached_entries.size();
+}
+
+void DeletionQueue::flush() {
+  std::vector<Entry> entries;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entries.swap(m_entries);
+  }
+}
+
+size_t DeletionQueue::getPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void DeletionQueue::enqueue(Entry&& entry) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.push_back(std::move(entry));
+}
+
+bool DeletionQueue::isReached(const Entry& entry) const {
+  if (entry.semaphore) {
+    return m_device.getSemaphoreCounterValue(entry.semaphore) >= entry.value;
+  }
+  if (entry.fence) {
+    return m_device.getFenceStatus(entry.fence) == vk::Result::eSuccess;
+  }
+  return true;
+}
+
+vk::Semaphore DeletionQueue::getSemaphoreHandle(
+    const TimelineSemaphore& semaphore) {
+  return semaphore.getSemaphore();
+}
+
+vk::Fence DeletionQueue::getFenceHandle(const Fence& fence) {
+  return fence.getFence();
+}
+
+}  // namespace pandora::core::gpu
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <ranges>
 
 #include "pandora/core/gpu.hpp"
 
@@ -39,4 +41,14 @@ DescriptionUnit::DescriptionUnit(
 
 DescriptionUnit::~DescriptionUnit() {}
 
+std::vector<uint32_t> DescriptionUnit::getSetIndices() const {
+  auto set_indices = m_descriptorInfoMap | std::views::values
+                     | std::views::transform(&DescriptorInfo::set)
+                     | std::ranges::to<std::vector<uint32_t>>();
+  std::ranges::sort(set_indices);
+  const auto [first, last] = std::ranges::unique(set_indices);
+  set_indices.erase(first, last);
+  return set_indices;
+}
+
 }  // namespace pandora::core::gpu
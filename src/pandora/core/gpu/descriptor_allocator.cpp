@@ -0,0 +1,170 @@
+#include "pandora/core/gpu/descriptor_allocator.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+#include "pandora/core/gpu.hpp"
+
+namespace pandora::core::gpu {
+
+DescriptorAllocator::DescriptorAllocator(
+    const Context& context,
+    DescriptorAllocatorMode mode,
+    uint32_t initial_sets_per_pool,
+    std::vector<PoolSizeRatio> pool_size_ratios)
+    : m_device(context.getPtrDevice()->getPtrLogicalDevice().get()),
+      m_ptrTracker(context.getPtrResourceTracker().get()),
+      m_mode(mode),
+      m_poolSizeRatios(std::move(pool_size_ratios)),
+      m_nextSetsPerPool(
+          std::clamp(initial_sets_per_pool, 1u, MAX_SETS_PER_POOL)) {}
+
+DescriptorAllocator::~DescriptorAllocator() {}
+
+DescriptorAllocator::Allocation DescriptorAllocator::allocate(
+    const DescriptorSetLayout& descriptor_set_layout) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto allocate_from = [&](Pool& pool) {
+    const auto descriptor_set =
+        m_device
+            .allocateDescriptorSets(
+                vk::DescriptorSetAllocateInfo{}
+                    .setDescriptorPool(pool.ptr_pool.get())
+                    .setSetLayouts(
+                        descriptor_set_layout.getDescriptorSetLayout()))
+            .front();
+    pool.live_set_count += 1u;
+    return Allocation{pool.ptr_pool.get(), descriptor_set};
+  };
+
+  while (!m_readyPools.empty()) {
+    auto& pool = *m_readyPools.back();
+    try {
+      return allocate_from(pool);
+    } catch (const vk::OutOfPoolMemoryError&) {
+    } catch (const vk::FragmentedPoolError&) {
+    }
+
+    pool.is_full = true;
+    m_readyPools.pop_back();
+  }
+
+  // A fresh pool is sized for this layout, so a failure here propagates
+  auto& pool = createPool(descriptor_set_layout);
+  m_readyPools.push_back(&pool);
+  return allocate_from(pool);
+}
+
+void DescriptorAllocator::free(const Allocation& allocation) {
+  if (m_mode != DescriptorAllocatorMode::Persistent
+      || !allocation.descriptor_set) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto it = std::ranges::find_if(m_pools, [&](const auto& ptr_pool) {
+    return ptr_pool->ptr_pool.get() == allocation.pool;
+  });
+  if (it == m_pools.end()) {
+    return;
+  }
+
+  auto& pool = **it;
+  m_device.freeDescriptorSets(pool.ptr_pool.get(), allocation.descriptor_set);
+  pool.live_set_count -= 1u;
+  if (pool.is_full) {
+    pool.is_full = false;
+    m_readyPools.insert(m_readyPools.begin(), &pool);
+  }
+}
+
+void DescriptorAllocator::reset() {
+  if (m_mode != DescriptorAllocatorMode::Transient) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_readyPools.clear();
+  for (const auto& ptr_pool : m_pools | std::views::reverse) {
+    m_device.resetDescriptorPool(ptr_pool->ptr_pool.get());
+    ptr_pool->live_set_count = 0u;
+    ptr_pool->is_full = false;
+    m_readyPools.push_back(ptr_pool.get());
+  }
+}
+
+size_t DescriptorAllocator::getPoolCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_pools.size();
+}
+
+std::vector<DescriptorAllocator::PoolSizeRatio>
+DescriptorAllocator::getDefaultPoolSizeRatios() {
+  return {
+      {vk::DescriptorType::eUniformBuffer, 2.0f},
+      {vk::DescriptorType::eStorageBuffer, 2.0f},
+      {vk::DescriptorType::eUniformBufferDynamic, 1.0f},
+      {vk::DescriptorType::eStorageBufferDynamic, 1.0f},
+      {vk::DescriptorType::eCombinedImageSampler, 4.0f},
+      {vk::DescriptorType::eSampledImage, 2.0f},
+      {vk::DescriptorType::eStorageImage, 1.0f},
+      {vk::DescriptorType::eSampler, 1.0f},
+      {vk::DescriptorType::eInputAttachment, 1.0f},
+  };
+}
+
+DescriptorAllocator::Pool& DescriptorAllocator::createPool(
+    const DescriptorSetLayout& descriptor_set_layout) {
+  const auto max_sets = m_nextSetsPerPool;
+  m_nextSetsPerPool = std::min(m_nextSetsPerPool * 2u, MAX_SETS_PER_POOL);
+
+  std::vector<vk::DescriptorPoolSize> pool_sizes;
+  for (const auto& ratio : m_poolSizeRatios) {
+    pool_sizes.emplace_back(
+        ratio.type,
+        std::max(1u, static_cast<uint32_t>(ratio.ratio * max_sets)));
+  }
+
+  // Guarantee room for the requesting layout even if no ratio covers it
+  std::vector<vk::DescriptorPoolSize> layout_sizes;
+  for (const auto& size : descriptor_set_layout.getDescriptorPoolSizes()) {
+    const auto it = std::ranges::find(
+        layout_sizes, size.type, &vk::DescriptorPoolSize::type);
+    if (it != layout_sizes.end()) {
+      it->descriptorCount += size.descriptorCount;
+    } else {
+      layout_sizes.push_back(size);
+    }
+  }
+  for (const auto& size : layout_sizes) {
+    const auto it =
+        std::ranges::find(pool_sizes, size.type, &vk::DescriptorPoolSize::type);
+    if (it == pool_sizes.end()) {
+      pool_sizes.push_back(size);
+    } else if (it->descriptorCount < size.descriptorCount) {
+      it->descriptorCount = size.descriptorCount;
+    }
+  }
+
+  auto pool_flags = vk::DescriptorPoolCreateFlags{};
+  if (m_mode == DescriptorAllocatorMode::Persistent) {
+    pool_flags |= vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
+  }
+
+  auto ptr_pool = std::make_unique<Pool>();
+  ptr_pool->ptr_pool = m_device.createDescriptorPoolUnique(
+      vk::DescriptorPoolCreateInfo{}
+          .setFlags(pool_flags)
+          .setMaxSets(max_sets)
+          .setPoolSizes(pool_sizes));
+  ptr_pool->tracking_token =
+      TrackedResourceToken(m_ptrTracker, TrackedResource::DescriptorPool);
+
+  m_pools.push_back(std::move(ptr_pool));
+  return *m_pools.back();
+}
+
+}  // namespace pandora::core::gpu
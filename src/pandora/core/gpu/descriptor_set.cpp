@@ -1,26 +1,47 @@
 #include <ranges>
+#include <utility>
 
 #include "pandora/core/gpu.hpp"
 
 namespace pandora::core::gpu {
 
-DescriptorSet::DescriptorSet(
-    const Context& context, const DescriptorSetLayout& description_set_layout) {
-  const auto& ptr_vk_device = context.getPtrDevice()->getPtrLogicalDevice();
+DescriptorSet::DescriptorSet(const Context& context,
+                             const DescriptorSetLayout& description_set_layout)
+    : DescriptorSet(description_set_layout,
+                    *context.getPtrDescriptorAllocator()) {}
+
+DescriptorSet::DescriptorSet(const DescriptorSetLayout& description_set_layout,
+                             DescriptorAllocator& descriptor_allocator)
+    : m_allocation(descriptor_allocator.allocate(description_set_layout)),
+      m_setIndex(description_set_layout.getSetIndex()) {
+  // Transient sets are recycled by DescriptorAllocator::reset()
+  if (descriptor_allocator.getMode() == DescriptorAllocatorMode::Persistent) {
+    m_ptrAllocator = &descriptor_allocator;
+  }
+}
 
-  m_ptrDescriptorPool = ptr_vk_device->createDescriptorPoolUnique(
-      description_set_layout.getDescriptorPoolInfo());
-  m_ptrDescriptorSet = std::move(
-      ptr_vk_device
-          ->allocateDescriptorSetsUnique(
-              vk::DescriptorSetAllocateInfo{}
-                  .setDescriptorPool(m_ptrDescriptorPool.get())
-                  .setSetLayouts(
-                      description_set_layout.getDescriptorSetLayout()))
-          .front());
+DescriptorSet::~DescriptorSet() {
+  if (m_ptrAllocator) {
+    m_ptrAllocator->free(m_allocation);
+  }
 }
 
-DescriptorSet::~DescriptorSet() {}
+DescriptorSet::DescriptorSet(DescriptorSet&& other) noexcept
+    : m_ptrAllocator(std::exchange(other.m_ptrAllocator, nullptr)),
+      m_allocation(std::exchange(other.m_allocation, {})),
+      m_setIndex(other.m_setIndex) {}
+
+DescriptorSet& DescriptorSet::operator=(DescriptorSet&& other) noexcept {
+  if (this != &other) {
+    if (m_ptrAllocator) {
+      m_ptrAllocator->free(m_allocation);
+    }
+    m_ptrAllocator = std::exchange(other.m_ptrAllocator, nullptr);
+    m_allocation = std::exchange(other.m_allocation, {});
+    m_setIndex = other.m_setIndex;
+  }
+  return *this;
+}
 
 void DescriptorSet::updateDescriptorSet(
     const Context& context,
@@ -38,7 +59,7 @@ void DescriptorSet::updateDescriptorSet(
        std::views::zip(buffer_descriptions, buffer_info_list)) {
     write_descriptor_sets.emplace_back(
         buffer_desc.createVkWriteDescriptorSet(buffer_info)
-            .setDstSet(m_ptrDescriptorSet.get()));
+            .setDstSet(m_allocation.descriptor_set));
   }
 
   const auto image_info_list =
@@ -50,16 +71,38 @@ void DescriptorSet::updateDescriptorSet(
        std::views::zip(image_descriptions, image_info_list)) {
     write_descriptor_sets.emplace_back(
         image_desc.createVkWriteDescriptorSet(image_info)
-            .setDstSet(m_ptrDescriptorSet.get()));
+            .setDstSet(m_allocation.descriptor_set));
   }
 
   context.getPtrDevice()->getPtrLogicalDevice()->updateDescriptorSets(
       write_descriptor_sets, nullptr);
 }
 
-void DescriptorSet::freeDescriptorSet(const Context& context) {
-  context.getPtrDevice()->getPtrLogicalDevice()->freeDescriptorSets(
-      m_ptrDescriptorPool.get(), m_ptrDescriptorSet.get());
+VoidResult DescriptorSet::updateDescriptorSet(
+    const Context& context,
+    const DescriptorUpdateTemplate& update_template,
+    std::span<const DescriptorData> descriptor_data) {
+  // The template reads one DescriptorData per slot; never read past the span
+  if (descriptor_data.size() < update_template.getSlotCount()) {
+    return Error::validation(
+               "Descriptor data is shorter than the template's slot count")
+        .withContext("DescriptorSet::updateDescriptorSet");
+  }
+
+  const auto& ptr_vk_device = context.getPtrDevice()->getPtrLogicalDevice();
+  ptr_vk_device->updateDescriptorSetWithTemplate(
+      m_allocation.descriptor_set,
+      update_template.getUpdateTemplate(),
+      descriptor_data.data());
+  return ok();
+}
+
+void DescriptorSet::freeDescriptorSet(const Context&) {
+  if (m_ptrAllocator) {
+    m_ptrAllocator->free(m_allocation);
+    m_ptrAllocator = nullptr;
+  }
+  m_allocation = {};
 }
 
 }  // namespace pandora::core::gpu
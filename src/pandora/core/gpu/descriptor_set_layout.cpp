@@ -5,12 +5,30 @@
 namespace pandora::core::gpu {
 
 DescriptorSetLayout::DescriptorSetLayout(
-    const Context& context, const DescriptionUnit& description_unit) {
+    const Context& context,
+    const DescriptionUnit& description_unit,
+    DescriptorSetLayoutType layout_type)
+    : DescriptorSetLayout(context, description_unit, 0u, layout_type) {}
+
+DescriptorSetLayout::DescriptorSetLayout(
+    const Context& context,
+    const DescriptionUnit& description_unit,
+    uint32_t set_index,
+    DescriptorSetLayoutType layout_type)
+    : m_setIndex(set_index), m_layoutType(layout_type) {
+  if (m_layoutType == DescriptorSetLayoutType::PushDescriptor
+      && !context.getPtrDevice()->hasPushDescriptor()) {
+    throw vk::FeatureNotPresentError(
+        "Push descriptor layouts require VK_KHR_push_descriptor");
+  }
+
   using D = std::ranges::range_value_t<
       decltype(description_unit.getDescriptorInfoMap() | std::views::values)>;
 
   const auto descriptor_set_layout_bindings =
       description_unit.getDescriptorInfoMap() | std::views::values
+      | std::views::filter(
+          [set_index](const D& x) { return x.set == set_index; })
       | std::views::transform(
           [&m_poolSizes = m_descriptorPoolSizes](const D& x) {
             m_poolSizes.push_back(vk::DescriptorPoolSize(x.type, 1u));
@@ -23,14 +41,14 @@ DescriptorSetLayout::DescriptorSetLayout(
           })
       | std::ranges::to<std::vector<vk::DescriptorSetLayoutBinding>>();
 
-  const auto descriptor_set_layout_info =
-      vk::DescriptorSetLayoutCreateInfo{}.setBindings(
-          descriptor_set_layout_bindings);
+  auto layout_flags = vk::DescriptorSetLayoutCreateFlags{};
+  if (m_layoutType == DescriptorSetLayoutType::PushDescriptor) {
+    layout_flags |= vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR;
+  }
 
-  m_ptrDescriptorSetLayout =
-      context.getPtrDevice()
-          ->getPtrLogicalDevice()
-          ->createDescriptorSetLayoutUnique(descriptor_set_layout_info);
+  m_descriptorSetLayout =
+      context.getPtrLayoutCache()->getDescriptorSetLayout(
+          descriptor_set_layout_bindings, layout_flags);
 }
 
 DescriptorSetLayout::~DescriptorSetLayout() {}
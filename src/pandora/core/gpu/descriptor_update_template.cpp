@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <ranges>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/gpu/vk_helper.hpp"
+
+namespace pandora::core::gpu {
+
+DescriptorData DescriptorData::fromBuffer(const Buffer& buffer,
+                                          vk::DeviceSize offset,
+                                          vk::DeviceSize range) {
+  DescriptorData data{};
+  data.buffer_info = vk::DescriptorBufferInfo{}
+                         .setBuffer(buffer.getBuffer())
+                         .setOffset(offset)
+                         .setRange(range);
+  return data;
+}
+
+DescriptorData DescriptorData::fromImage(const ImageView& image_view,
+                                         ImageLayout image_layout) {
+  DescriptorData data{};
+  data.image_info =
+      vk::DescriptorImageInfo{}
+          .setImageView(image_view.getImageView())
+          .setImageLayout(vk_helper::getImageLayout(image_layout));
+  return data;
+}
+
+DescriptorData DescriptorData::fromImage(const ImageView& image_view,
+                                         ImageLayout image_layout,
+                                         const Sampler& sampler) {
+  DescriptorData data{};
+  data.image_info =
+      vk::DescriptorImageInfo{}
+          .setImageView(image_view.getImageView())
+          .setImageLayout(vk_helper::getImageLayout(image_layout))
+          .setSampler(sampler.getSampler());
+  return data;
+}
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+    const Context& context,
+    const DescriptionUnit& description_unit,
+    const DescriptorSetLayout& descriptor_set_layout) {
+  const auto set_index = descriptor_set_layout.getSetIndex();
+  auto descriptor_infos =
+      description_unit.getDescriptorInfoMap() | std::views::values
+      | std::views::filter([set_index](const DescriptorInfo& info) {
+          return info.set == set_index;
+        })
+      | std::ranges::to<std::vector<DescriptorInfo>>();
+  std::ranges::sort(descriptor_infos, {}, &DescriptorInfo::binding);
+
+  std::vector<vk::DescriptorUpdateTemplateEntry> entries;
+  for (const auto& [slot, descriptor_info] :
+       std::views::enumerate(descriptor_infos)) {
+    entries.push_back(
+        vk::DescriptorUpdateTemplateEntry{}
+            .setDstBinding(descriptor_info.binding)
+            .setDstArrayElement(0u)
+            .setDescriptorCount(1u)
+            .setDescriptorType(descriptor_info.type)
+            .setOffset(static_cast<size_t>(slot) * sizeof(DescriptorData))
+            .setStride(sizeof(DescriptorData)));
+    m_slotBindings.push_back(descriptor_info.binding);
+  }
+
+  m_ptrUpdateTemplate =
+      context.getPtrDevice()
+          ->getPtrLogicalDevice()
+          ->createDescriptorUpdateTemplateUnique(
+              vk::DescriptorUpdateTemplateCreateInfo{}
+                  .setDescriptorUpdateEntries(entries)
+                  .setTemplateType(
+                      vk::DescriptorUpdateTemplateType::eDescriptorSet)
+                  .setDescriptorSetLayout(
+                      descriptor_set_layout.getDescriptorSetLayout()));
+}
+
+DescriptorUpdateTemplate::~DescriptorUpdateTemplate() {}
+
+Result<size_t> DescriptorUpdateTemplate::getSlot(uint32_t binding) const {
+  const auto it = std::ranges::find(m_slotBindings, binding);
+  if (it == m_slotBindings.end()) {
+    return Error::validation("Binding is not part of the update template")
+        .withContext("DescriptorUpdateTemplate::getSlot");
+  }
+  return static_cast<size_t>(std::distance(m_slotBindings.begin(), it));
+}
+
+}  // namespace pandora::core::gpu
@@ -160,10 +160,13 @@ Device::Device(const vk::UniqueInstance& instance,
     return;
   }
 
+  // Queried once; resource creation reads the cached copies
+  m_properties = m_physicalDevice.getProperties();
+  m_memoryProperties = m_physicalDevice.getMemoryProperties();
+
 #ifdef GPU_DEBUG
   if (m_physicalDevice) {
-    std::println("vulkan_device: {}",
-                 m_physicalDevice.getProperties().deviceName.data());
+    std::println("vulkan_device: {}", m_properties.deviceName.data());
   }
   constructLogicalDevice(messenger);
 #else
@@ -209,6 +212,31 @@ void Device::constructLogicalDevice(
   enabled_v12_features.setTimelineSemaphore(
       supported_v12_features.timelineSemaphore);
 
+  // Descriptor indexing backs BindlessHeap; enabled only as a complete set
+  m_hasDescriptorIndexing =
+      supported_v12_features.descriptorIndexing
+      && supported_v12_features.runtimeDescriptorArray
+      && supported_v12_features.descriptorBindingPartiallyBound
+      && supported_v12_features.descriptorBindingUpdateUnusedWhilePending
+      && supported_v12_features.descriptorBindingSampledImageUpdateAfterBind
+      && supported_v12_features.descriptorBindingStorageImageUpdateAfterBind
+      && supported_v12_features.descriptorBindingStorageBufferUpdateAfterBind
+      && supported_v12_features.shaderSampledImageArrayNonUniformIndexing
+      && supported_v12_features.shaderStorageImageArrayNonUniformIndexing
+      && supported_v12_features.shaderStorageBufferArrayNonUniformIndexing;
+  if (m_hasDescriptorIndexing) {
+    enabled_v12_features.setDescriptorIndexing(true)
+        .setRuntimeDescriptorArray(true)
+        .setDescriptorBindingPartiallyBound(true)
+        .setDescriptorBindingUpdateUnusedWhilePending(true)
+        .setDescriptorBindingSampledImageUpdateAfterBind(true)
+        .setDescriptorBindingStorageImageUpdateAfterBind(true)
+        .setDescriptorBindingStorageBufferUpdateAfterBind(true)
+        .setShaderSampledImageArrayNonUniformIndexing(true)
+        .setShaderStorageImageArrayNonUniformIndexing(true)
+        .setShaderStorageBufferArrayNonUniformIndexing(true);
+  }
+
   vk::PhysicalDeviceVulkan13Features enabled_v13_features;
   enabled_v13_features.setSynchronization2(
       supported_v13_features.synchronization2);
@@ -217,9 +245,24 @@ void Device::constructLogicalDevice(
   features2.setPNext(&enabled_v13_features);
   enabled_v13_features.setPNext(&enabled_v12_features);
 
-  const auto required_extensions = getDeviceExtensions(m_hasWindowSurface);
+  auto device_extensions = getDeviceExtensions(m_hasWindowSurface);
+
+  // Optional: per-heap budget reporting for Context::memoryStats()
+  m_hasMemoryBudget = check_device_extension_support(
+      m_physicalDevice, {VK_EXT_MEMORY_BUDGET_EXTENSION_NAME});
+  if (m_hasMemoryBudget) {
+    device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+  }
+
+  // Optional: push descriptors for CommandBuffer::pushDescriptors()
+  m_hasPushDescriptor = check_device_extension_support(
+      m_physicalDevice, {VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME});
+  if (m_hasPushDescriptor) {
+    device_extensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+  }
+
   vk::DeviceCreateInfo create_info(
-      {}, queue_create_infos, {}, required_extensions, nullptr, &features2);
+      {}, queue_create_infos, {}, device_extensions, nullptr, &features2);
 
 #ifdef GPU_DEBUG
   create_info.setPEnabledLayerNames(messenger.getValidationLayers());
@@ -248,10 +291,8 @@ vk::Queue Device::getQueue(uint32_t queue_family_index) {
 }
 
 vk::SampleCountFlagBits Device::getMaxUsableSampleCount() const {
-  const auto physical_device_props = m_physicalDevice.getProperties();
-  const auto sample_count =
-      physical_device_props.limits.framebufferColorSampleCounts
-      & physical_device_props.limits.framebufferDepthSampleCounts;
+  const auto sample_count = m_properties.limits.framebufferColorSampleCounts
+                            & m_properties.limits.framebufferDepthSampleCounts;
 
   // Check sample counts in descending order to find the maximum supported
   constexpr std::array sample_priorities = {vk::SampleCountFlagBits::e64,
@@ -48,7 +48,8 @@ Image::Image(const Context& context,
              MemoryUsage memory_usage,
              TransferType transfer_type,
              const std::vector<ImageUsage>& image_usages,
-             const ImageSubInfo& image_sub_info) {
+             const ImageSubInfo& image_sub_info,
+             AllocationStrategy allocation_strategy) {
   const auto& ptr_vk_device = context.getPtrDevice()->getPtrLogicalDevice();
 
   {
@@ -89,34 +90,28 @@ Image::Image(const Context& context,
     m_ptrImage = ptr_vk_device->createImageUnique(image_info);
   }
 
-  {
-    const auto memory_requirements =
-        ptr_vk_device->getImageMemoryRequirements(m_ptrImage.get());
-    const auto vk_memory_usage =
-        vk_helper::getMemoryPropertyFlags(memory_usage);
-    const auto memory_props =
-        context.getPtrDevice()->getPhysicalDevice().getMemoryProperties();
-
-    uint32_t memory_type_idx = 0u;
-    for (; memory_type_idx < memory_props.memoryTypeCount;
-         memory_type_idx += 1u) {
-      if ((memory_requirements.memoryTypeBits & (1u << memory_type_idx))
-          && (memory_props.memoryTypes.at(memory_type_idx).propertyFlags
-              & vk_memory_usage)
-                 == vk_memory_usage) {
-        break;
-      }
-    }
+  m_memoryAllocation = context.getPtrAllocator()->allocateForImage(
+      m_ptrImage.get(),
+      vk_helper::getMemoryTypeRequest(memory_usage),
+      allocation_strategy);
 
-    m_ptrMemory = ptr_vk_device->allocateMemoryUnique(
-        vk::MemoryAllocateInfo{}
-            .setMemoryTypeIndex(memory_type_idx)
-            .setAllocationSize(memory_requirements.size));
-  }
+  ptr_vk_device->bindImageMemory(m_ptrImage.get(),
+                                 m_memoryAllocation.getMemory(),
+                                 m_memoryAllocation.getOffset());
 
-  ptr_vk_device->bindImageMemory(m_ptrImage.get(), m_ptrMemory.get(), 0u);
+  m_trackingToken = TrackedResourceToken(context.getPtrResourceTracker().get(),
+                                         TrackedResource::Image);
+  m_ptrViewCache = context.getPtrImageViewCache().get();
 }
 
-Image::~Image() {}
+Image::~Image() {
+  purgeCachedViews();
+}
+
+void Image::purgeCachedViews() noexcept {
+  if (m_ptrViewCache != nullptr && m_ptrImage) {
+    m_ptrViewCache->purgeImage(m_ptrImage.get());
+  }
+}
 
 }  // namespace pandora::core::gpu
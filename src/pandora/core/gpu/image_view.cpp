@@ -26,7 +26,8 @@ namespace pandora::core::gpu {
 
 ImageView::ImageView(const Context& context,
                      const Image& image,
-                     const ImageViewInfo& image_view_info) {
+                     const ImageViewInfo& image_view_info)
+    : m_imageViewInfo(image_view_info) {
   const auto create_info =
       vk::ImageViewCreateInfo()
           .setSubresourceRange(
@@ -46,10 +47,7 @@ ImageView::ImageView(const Context& context,
           .setFormat(image.getFormat())
           .setImage(image.getImage());
 
-  m_ptrImageView =
-      context.getPtrDevice()->getPtrLogicalDevice()->createImageViewUnique(
-          create_info);
-  m_ptrImageViewInfo = std::make_unique<ImageViewInfo>(image_view_info);
+  m_ptrImageView = context.getPtrImageViewCache()->acquire(create_info);
 }
 
 ImageView::~ImageView() {}
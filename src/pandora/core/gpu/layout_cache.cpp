@@ -0,0 +1,119 @@
+#include "pandora/core/gpu/layout_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
+
+namespace {
+
+uint64_t hash_descriptor_set_layout(
+    const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
+    vk::DescriptorSetLayoutCreateFlags flags) {
+  pandora::core::HashBuilder hash_builder{};
+  hash_builder.add(flags).add(bindings.size());
+  for (const auto& binding : bindings) {
+    hash_builder.add(binding.binding)
+        .add(binding.descriptorType)
+        .add(binding.descriptorCount)
+        .add(binding.stageFlags);
+  }
+  return hash_builder.get();
+}
+
+uint64_t hash_pipeline_layout(
+    const std::vector<vk::DescriptorSetLayout>& set_layouts,
+    const std::vector<vk::PushConstantRange>& push_constant_ranges) {
+  pandora::core::HashBuilder hash_builder{};
+  hash_builder.add(set_layouts.size());
+  for (const auto& set_layout : set_layouts) {
+    hash_builder.add(std::hash<VkDescriptorSetLayout>{}(
+        static_cast<VkDescriptorSetLayout>(set_layout)));
+  }
+  hash_builder.add(push_constant_ranges.size());
+  for (const auto& range : push_constant_ranges) {
+    hash_builder.add(range.stageFlags).add(range.offset).add(range.size);
+  }
+  return hash_builder.get();
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+LayoutCache::LayoutCache(const Device& device)
+    : m_device(device.getPtrLogicalDevice().get()) {}
+
+LayoutCache::~LayoutCache() {}
+
+vk::DescriptorSetLayout LayoutCache::getDescriptorSetLayout(
+    std::vector<vk::DescriptorSetLayoutBinding> bindings,
+    vk::DescriptorSetLayoutCreateFlags flags) {
+  std::ranges::sort(bindings, {}, &vk::DescriptorSetLayoutBinding::binding);
+  const auto key = hash_descriptor_set_layout(bindings, flags);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto [first, last] = m_descriptorSetLayouts.equal_range(key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.flags == flags && it->second.bindings == bindings) {
+      return it->second.ptr_layout.get();
+    }
+  }
+
+  auto ptr_layout = m_device.createDescriptorSetLayoutUnique(
+      vk::DescriptorSetLayoutCreateInfo{}.setFlags(flags).setBindings(
+          bindings));
+  const auto layout = ptr_layout.get();
+  m_descriptorSetLayouts.emplace(
+      key,
+      DescriptorSetLayoutEntry{
+          flags, std::move(bindings), std::move(ptr_layout)});
+  return layout;
+}
+
+vk::PipelineLayout LayoutCache::getPipelineLayout(
+    const std::vector<vk::DescriptorSetLayout>& set_layouts,
+    std::vector<vk::PushConstantRange> push_constant_ranges) {
+  std::ranges::sort(push_constant_ranges, [](const auto& a, const auto& b) {
+    return std::tuple(a.offset, static_cast<VkShaderStageFlags>(a.stageFlags))
+           < std::tuple(b.offset,
+                        static_cast<VkShaderStageFlags>(b.stageFlags));
+  });
+  const auto key = hash_pipeline_layout(set_layouts, push_constant_ranges);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto [first, last] = m_pipelineLayouts.equal_range(key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.set_layouts == set_layouts
+        && it->second.push_constant_ranges == push_constant_ranges) {
+      return it->second.ptr_layout.get();
+    }
+  }
+
+  auto ptr_layout = m_device.createPipelineLayoutUnique(
+      vk::PipelineLayoutCreateInfo{}
+          .setSetLayouts(set_layouts)
+          .setPushConstantRanges(push_constant_ranges));
+  const auto layout = ptr_layout.get();
+  m_pipelineLayouts.emplace(key,
+                            PipelineLayoutEntry{set_layouts,
+                                                std::move(push_constant_ranges),
+                                                std::move(ptr_layout)});
+  return layout;
+}
+
+size_t LayoutCache::getDescriptorSetLayoutCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_descriptorSetLayouts.size();
+}
+
+size_t LayoutCache::getPipelineLayoutCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_pipelineLayouts.size();
+}
+
+}  // namespace pandora::core::gpu
@@ -0,0 +1,47 @@
+#include "pandora/core/gpu/memory_stats.hpp"
+
+#include <nlohmann/json.hpp>
+
+namespace pandora::core::gpu {
+
+std::string MemoryStats::toJson(int32_t indent) const {
+  auto heaps_json = nlohmann::json::array();
+  for (const auto& heap : heaps) {
+    nlohmann::json heap_json{
+        {"heap_index", heap.heap_index},
+        {"heap_size", heap.heap_size},
+        {"is_device_local", heap.is_device_local},
+        {"allocated_bytes", heap.allocated_bytes},
+        {"used_bytes", heap.used_bytes},
+    };
+    heap_json["budget_bytes"] = heap.budget_bytes.has_value()
+                                    ? nlohmann::json(heap.budget_bytes.value())
+                                    : nlohmann::json(nullptr);
+    heap_json["process_usage_bytes"] =
+        heap.process_usage_bytes.has_value()
+            ? nlohmann::json(heap.process_usage_bytes.value())
+            : nlohmann::json(nullptr);
+    heaps_json.push_back(std::move(heap_json));
+  }
+
+  const nlohmann::json stats_json{
+      {"heaps", std::move(heaps_json)},
+      {"live_resources",
+       {
+           {"buffers", live_resources.buffers},
+           {"images", live_resources.images},
+           {"descriptor_pools", live_resources.descriptor_pools},
+           {"pipelines", live_resources.pipelines},
+       }},
+      {"device_memory_count", device_memory_count},
+      {"total_allocation_count", total_allocation_count},
+      {"total_free_count", total_free_count},
+      {"frame_allocation_count", frame_allocation_count},
+      {"frame_free_count", frame_free_count},
+      {"has_memory_budget", has_memory_budget},
+  };
+
+  return stats_json.dump(indent);
+}
+
+}  // namespace pandora::core::gpu
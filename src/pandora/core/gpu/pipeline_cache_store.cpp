@@ -0,0 +1,167 @@
+#include "pandora/core/gpu/pipeline_cache_store.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <random>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
+
+namespace {
+
+constexpr uint32_t FILE_MAGIC = 0x43504450u;  // "PDPC"
+constexpr uint32_t FILE_VERSION = 1u;
+
+/// @brief Header written in front of the driver's cache data
+struct FileHeader {
+  uint32_t magic = FILE_MAGIC;
+  uint32_t version = FILE_VERSION;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE]{};
+  uint32_t reserved = 0u;  ///< Keeps data_size aligned without padding
+  uint64_t data_size = 0u;
+  uint64_t data_checksum = 0u;
+};
+static_assert(sizeof(FileHeader) == 56u, "FileHeader must not be padded");
+
+uint64_t compute_checksum(const uint8_t* data, size_t size) {
+  return pandora::core::HashBuilder{}.addBytes(data, size).get();
+}
+
+FileHeader make_header(const vk::PhysicalDeviceProperties& properties) {
+  FileHeader header{};
+  header.vendor_id = properties.vendorID;
+  header.device_id = properties.deviceID;
+  header.driver_version = properties.driverVersion;
+  std::memcpy(header.pipeline_cache_uuid,
+              properties.pipelineCacheUUID.data(),
+              VK_UUID_SIZE);
+  return header;
+}
+
+/// @brief Read cache data from file, or nothing if it is not usable here
+std::vector<uint8_t> read_cache_file(
+    const std::filesystem::path& file_path,
+    const vk::PhysicalDeviceProperties& properties) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file.is_open()) {
+    return {};
+  }
+
+  FileHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return {};
+  }
+
+  const auto expected = make_header(properties);
+  if (header.magic != expected.magic || header.version != expected.version
+      || header.vendor_id != expected.vendor_id
+      || header.device_id != expected.device_id
+      || header.driver_version != expected.driver_version
+      || std::memcmp(header.pipeline_cache_uuid,
+                     expected.pipeline_cache_uuid,
+                     VK_UUID_SIZE)
+             != 0) {
+    return {};
+  }
+
+  std::error_code error_code;
+  const auto file_size = std::filesystem::file_size(file_path, error_code);
+  if (error_code || header.data_size != file_size - sizeof(header)) {
+    return {};
+  }
+
+  std::vector<uint8_t> data(static_cast<size_t>(header.data_size));
+  if (!file.read(reinterpret_cast<char*>(data.data()),
+                 static_cast<std::streamsize>(data.size()))
+      || compute_checksum(data.data(), data.size()) != header.data_checksum) {
+    return {};
+  }
+
+  return data;
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+PipelineCacheStore::PipelineCacheStore(const Device& device,
+                                       std::filesystem::path file_path)
+    : m_device(device.getPtrLogicalDevice().get()),
+      m_deviceProperties(device.getProperties()),
+      m_filePath(std::move(file_path)) {
+  std::vector<uint8_t> initial_data;
+  if (!m_filePath.empty()) {
+    initial_data = read_cache_file(m_filePath, m_deviceProperties);
+  }
+
+  try {
+    m_ptrPipelineCache = m_device.createPipelineCacheUnique(
+        vk::PipelineCacheCreateInfo{}.setInitialData<uint8_t>(initial_data));
+    m_isLoadedFromFile = !initial_data.empty();
+  } catch (const vk::SystemError&) {
+    // The driver rejected the data after all; start from an empty cache
+    m_ptrPipelineCache =
+        m_device.createPipelineCacheUnique(vk::PipelineCacheCreateInfo{});
+  }
+}
+
+PipelineCacheStore::~PipelineCacheStore() {}
+
+VoidResult PipelineCacheStore::save() const {
+  if (m_filePath.empty()) {
+    return ok();
+  }
+  return save(m_filePath);
+}
+
+VoidResult PipelineCacheStore::save(
+    const std::filesystem::path& file_path) const {
+  const auto data = m_device.getPipelineCacheData(m_ptrPipelineCache.get());
+
+  auto header = make_header(m_deviceProperties);
+  header.data_size = data.size();
+  header.data_checksum = compute_checksum(data.data(), data.size());
+
+  std::error_code error_code;
+  if (file_path.has_parent_path()) {
+    std::filesystem::create_directories(file_path.parent_path(), error_code);
+  }
+
+  // Unique per writer, so concurrent saves never share a temporary file
+  auto temp_path = file_path;
+  temp_path += std::format(".{:08x}.tmp", std::random_device{}());
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return Error::io("Failed to open pipeline cache file: "
+                       + temp_path.string())
+          .withContext("PipelineCacheStore::save");
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()),
+               static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, error_code);
+      return Error::io("Failed to write pipeline cache file: "
+                       + temp_path.string())
+          .withContext("PipelineCacheStore::save");
+    }
+  }
+
+  std::filesystem::rename(temp_path, file_path, error_code);
+  if (error_code) {
+    std::filesystem::remove(temp_path, error_code);
+    return Error::io("Failed to replace pipeline cache file: "
+                     + file_path.string())
+        .withContext("PipelineCacheStore::save");
+  }
+
+  return ok();
+}
+
+}  // namespace pandora::core::gpu
@@ -6,19 +6,32 @@ namespace pandora::core::gpu {
 BufferDescription::BufferDescription(const DescriptorInfo& descriptor_info,
                                      const Buffer& buffer) {
   m_bufferInfo.buffer = buffer.getBuffer();
+  m_bufferInfo.offset = 0u;
   m_bufferInfo.size = buffer.getSize();
 
   m_writeDescInfo.binding = descriptor_info.binding;
   m_writeDescInfo.type = descriptor_info.type;
 }
 
+BufferDescription::BufferDescription(const DescriptorInfo& descriptor_info,
+                                     const Buffer& buffer,
+                                     size_t offset,
+                                     size_t range) {
+  m_bufferInfo.buffer = buffer.getBuffer();
+  m_bufferInfo.offset = offset;
+  m_bufferInfo.size = range;
+
+  m_writeDescInfo.binding = descriptor_info.binding;
+  m_writeDescInfo.type = descriptor_info.type;
+}
+
 BufferDescription::~BufferDescription() {}
 
 vk::DescriptorBufferInfo BufferDescription::createVkBufferInfo() const {
   return vk::DescriptorBufferInfo{}
       .setBuffer(m_bufferInfo.buffer)
       .setRange(m_bufferInfo.size)
-      .setOffset(0u);
+      .setOffset(m_bufferInfo.offset);
 }
 
 vk::WriteDescriptorSet BufferDescription::createVkWriteDescriptorSet(
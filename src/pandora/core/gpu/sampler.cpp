@@ -24,9 +24,7 @@ Sampler::Sampler(const Context& context, const SamplerInfo& sampler_info) {
           .setMaxLod(sampler_info.max_lod)
           .setUnnormalizedCoordinates(sampler_info.unnormalized_coordinates);
 
-  m_ptrSampler =
-      context.getPtrDevice()->getPtrLogicalDevice()->createSamplerUnique(
-          sampler_create_info);
+  m_ptrSampler = context.getPtrSamplerCache()->acquire(sampler_create_info);
 }
 
 Sampler::~Sampler() {}
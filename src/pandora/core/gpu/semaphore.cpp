@@ -19,4 +19,23 @@ TimelineSemaphore::TimelineSemaphore(const Context& context) {
 
 TimelineSemaphore::~TimelineSemaphore() {}
 
+uint64_t TimelineSemaphore::getCounterValue(const Context& context) const {
+  return context.getPtrDevice()
+      ->getPtrLogicalDevice()
+      ->getSemaphoreCounterValue(m_ptrSemaphore.get());
+}
+
+bool TimelineSemaphore::wait(const Context& context,
+                             uint64_t value,
+                             uint64_t timeout) const {
+  const auto semaphore_wait_info = vk::SemaphoreWaitInfo{}
+                                       .setSemaphores(m_ptrSemaphore.get())
+                                       .setValues(value);
+  const auto vk_result =
+      context.getPtrDevice()->getPtrLogicalDevice()->waitSemaphores(
+          semaphore_wait_info, timeout);
+
+  return vk_result == vk::Result::eSuccess;
+}
+
 }  // namespace pandora::core::gpu
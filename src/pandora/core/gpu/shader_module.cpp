@@ -1,6 +1,15 @@
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
 #include <spirv_cross/spirv_cross.hpp>
+#include <type_traits>
 
 #include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
+#include "pandora/core/io.hpp"
 
 class ShaderCompiler : public spirv_cross::Compiler {
  public:
@@ -86,6 +95,8 @@ void set_descriptor_infos(
             .setType(descriptor_type)
             .setSize(get_type_size(compiler,
                                    compiler.get_type(resource.base_type_id)))
+            .setSet(compiler.get_decoration(resource.id,
+                                            spv::DecorationDescriptorSet))
             .setBinding(
                 compiler.get_decoration(resource.id, spv::DecorationBinding))
             .setStageFlags(shader_stage_flags);
@@ -166,19 +177,305 @@ ShaderCompiler::getPushConstantRanges() const {
   return push_constant_range_map;
 }
 
+namespace {
+
+constexpr uint32_t SIDECAR_MAGIC = 0x4c465250u;  // "PRFL"
+constexpr uint32_t SIDECAR_VERSION = 1u;
+
+/// @brief Reflection results of one SPIR-V binary
+struct Reflection {
+  std::string entry_point_name;
+  vk::ShaderStageFlagBits shader_stage_flag{};
+  std::unordered_map<std::string, pandora::core::DescriptorInfo>
+      descriptor_info_map;
+  std::unordered_map<std::string, pandora::core::PushConstantRange>
+      push_constant_range_map;
+};
+
+/// @brief Header written in front of a serialized Reflection
+struct SidecarHeader {
+  uint32_t magic = SIDECAR_MAGIC;
+  uint32_t version = SIDECAR_VERSION;
+  uint64_t key = 0u;
+  uint64_t payload_size = 0u;
+  uint64_t payload_checksum = 0u;
+};
+
+class ByteWriter {
+ private:
+  std::vector<uint8_t> m_bytes;
+
+ public:
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  ByteWriter& put(T value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    m_bytes.insert(m_bytes.end(), bytes, bytes + sizeof(value));
+    return *this;
+  }
+
+  ByteWriter& put(const std::string& value) {
+    put(static_cast<uint32_t>(value.size()));
+    m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+    return *this;
+  }
+
+  const auto& getBytes() const {
+    return m_bytes;
+  }
+};
+
+class ByteReader {
+ private:
+  std::span<const uint8_t> m_bytes;
+  bool m_isValid = true;
+
+ public:
+  explicit ByteReader(std::span<const uint8_t> bytes) : m_bytes(bytes) {}
+
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  T get() {
+    T value{};
+    if (m_bytes.size() < sizeof(value)) {
+      m_isValid = false;
+      return value;
+    }
+    std::memcpy(&value, m_bytes.data(), sizeof(value));
+    m_bytes = m_bytes.subspan(sizeof(value));
+    return value;
+  }
+
+  std::string getString() {
+    const auto size = get<uint32_t>();
+    if (m_bytes.size() < size) {
+      m_isValid = false;
+      return {};
+    }
+    std::string value(reinterpret_cast<const char*>(m_bytes.data()), size);
+    m_bytes = m_bytes.subspan(size);
+    return value;
+  }
+
+  /// @brief Check that no read ran past the end
+  bool isValid() const {
+    return m_isValid;
+  }
+
+  /// @brief Check that every read succeeded and all bytes were consumed
+  bool isComplete() const {
+    return m_isValid && m_bytes.empty();
+  }
+};
+
+Reflection reflect(const std::vector<uint32_t>& spirv_binary) {
+  ShaderCompiler compiler(spirv_binary);
+
+  return Reflection{compiler.getEntryPointName(),
+                    compiler.getShaderStageFlagBits(),
+                    compiler.getDescriptorInfos(),
+                    compiler.getPushConstantRanges()};
+}
+
+std::vector<uint8_t> serialize(const Reflection& reflection) {
+  ByteWriter writer{};
+  writer.put(reflection.entry_point_name)
+      .put(static_cast<uint32_t>(reflection.shader_stage_flag));
+
+  writer.put(static_cast<uint32_t>(reflection.descriptor_info_map.size()));
+  for (const auto& [name, info] : reflection.descriptor_info_map) {
+    writer.put(name)
+        .put(static_cast<VkShaderStageFlags>(info.stage_flags))
+        .put(info.set)
+        .put(info.binding)
+        .put(static_cast<uint32_t>(info.type))
+        .put(info.size);
+  }
+
+  writer.put(static_cast<uint32_t>(reflection.push_constant_range_map.size()));
+  for (const auto& [name, range] : reflection.push_constant_range_map) {
+    writer.put(name)
+        .put(static_cast<VkShaderStageFlags>(range.stage_flags))
+        .put(range.offset)
+        .put(static_cast<uint64_t>(range.size));
+  }
+
+  return writer.getBytes();
+}
+
+std::optional<Reflection> deserialize(std::span<const uint8_t> bytes) {
+  ByteReader reader(bytes);
+  Reflection reflection{};
+  reflection.entry_point_name = reader.getString();
+  reflection.shader_stage_flag =
+      static_cast<vk::ShaderStageFlagBits>(reader.get<uint32_t>());
+
+  const auto descriptor_count = reader.get<uint32_t>();
+  for (uint32_t i = 0u; i < descriptor_count && reader.isValid(); i += 1u) {
+    auto name = reader.getString();
+    const auto stage_flags = reader.get<VkShaderStageFlags>();
+    const auto set = reader.get<uint32_t>();
+    const auto binding = reader.get<uint32_t>();
+    const auto type = reader.get<uint32_t>();
+    const auto size = reader.get<uint32_t>();
+
+    reflection.descriptor_info_map.insert(
+        {std::move(name),
+         pandora::core::DescriptorInfo{}
+             .setStageFlags(vk::ShaderStageFlags(stage_flags))
+             .setSet(set)
+             .setBinding(binding)
+             .setType(static_cast<vk::DescriptorType>(type))
+             .setSize(size)});
+  }
+
+  const auto push_constant_count = reader.get<uint32_t>();
+  for (uint32_t i = 0u; i < push_constant_count && reader.isValid();
+       i += 1u) {
+    auto name = reader.getString();
+    const auto stage_flags = reader.get<VkShaderStageFlags>();
+    const auto offset = reader.get<uint32_t>();
+    const auto size = reader.get<uint64_t>();
+
+    reflection.push_constant_range_map.insert(
+        {std::move(name),
+         pandora::core::PushConstantRange{}
+             .setStageFlags(vk::ShaderStageFlags(stage_flags))
+             .setOffset(offset)
+             .setSize(static_cast<size_t>(size))});
+  }
+
+  if (!reader.isComplete()) {
+    return std::nullopt;
+  }
+  return reflection;
+}
+
+uint64_t compute_checksum(std::span<const uint8_t> bytes) {
+  return pandora::core::HashBuilder{}
+      .addBytes(bytes.data(), bytes.size())
+      .get();
+}
+
+std::filesystem::path sidecar_path(const std::filesystem::path& directory,
+                                   uint64_t key) {
+  return directory / std::format("{:016x}.refl", key);
+}
+
+/// @brief Read a sidecar, or nothing if it is missing or broken
+std::optional<Reflection> read_sidecar(const std::filesystem::path& directory,
+                                       uint64_t key) {
+  const auto file_path = sidecar_path(directory, key);
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  SidecarHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+      || header.magic != SIDECAR_MAGIC || header.version != SIDECAR_VERSION
+      || header.key != key) {
+    return std::nullopt;
+  }
+
+  std::error_code error_code;
+  const auto file_size = std::filesystem::file_size(file_path, error_code);
+  if (error_code || header.payload_size != file_size - sizeof(header)) {
+    return std::nullopt;
+  }
+
+  std::vector<uint8_t> payload(static_cast<size_t>(header.payload_size));
+  if (!file.read(reinterpret_cast<char*>(payload.data()),
+                 static_cast<std::streamsize>(payload.size()))
+      || compute_checksum(payload) != header.payload_checksum) {
+    return std::nullopt;
+  }
+
+  return deserialize(payload);
+}
+
+/// @brief Store a sidecar
+/// @details Best effort, written through a temporary file like compile cache
+/// entries: a failed write only costs another spirv-cross pass next time.
+void write_sidecar(const std::filesystem::path& directory,
+                   uint64_t key,
+                   const Reflection& reflection) {
+  std::error_code error_code;
+  std::filesystem::create_directories(directory, error_code);
+  if (error_code) {
+    return;
+  }
+
+  const auto payload = serialize(reflection);
+  SidecarHeader header{};
+  header.key = key;
+  header.payload_size = payload.size();
+  header.payload_checksum = compute_checksum(payload);
+
+  const auto file_path = sidecar_path(directory, key);
+  auto temp_path = file_path;
+  temp_path += std::format(".{:08x}.tmp", std::random_device{}());
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(payload.data()),
+               static_cast<std::streamsize>(payload.size()));
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, error_code);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temp_path, file_path, error_code);
+  if (error_code) {
+    std::filesystem::remove(temp_path, error_code);
+  }
+}
+
+/// @brief Load reflection from its sidecar, running spirv-cross on a miss
+Reflection load_reflection(const std::vector<uint32_t>& spirv_binary,
+                           uint64_t spirv_hash) {
+  const auto directory = pandora::core::io::shader::getCompileCacheDirectory();
+  if (directory.empty()) {
+    return reflect(spirv_binary);
+  }
+
+  const auto key = pandora::core::HashBuilder{spirv_hash}
+                       .add(SIDECAR_VERSION)
+                       .get();
+  if (auto reflection = read_sidecar(directory, key)) {
+    return std::move(reflection.value());
+  }
+
+  auto reflection = reflect(spirv_binary);
+  write_sidecar(directory, key, reflection);
+  return reflection;
+}
+
+}  // namespace
+
 namespace pandora::core::gpu {
 
 ShaderModule::ShaderModule(const Context& context,
                            const std::vector<uint32_t>& spirv_binary) {
+  const auto spirv_hash =
+      HashBuilder{}.add(std::span<const uint32_t>(spirv_binary)).get();
+
   {
-    ShaderCompiler compiler(spirv_binary);
+    auto reflection = load_reflection(spirv_binary, spirv_hash);
 
-    m_entryPointName = compiler.getEntryPointName();
-    m_descriptorInfoMap = compiler.getDescriptorInfos();
-    m_pushConstantRangeMap = compiler.getPushConstantRanges();
-    m_shaderStageFlag = compiler.getShaderStageFlagBits();
+    m_entryPointName = std::move(reflection.entry_point_name);
+    m_descriptorInfoMap = std::move(reflection.descriptor_info_map);
+    m_pushConstantRangeMap = std::move(reflection.push_constant_range_map);
+    m_shaderStageFlag = reflection.shader_stage_flag;
   }
 
+  m_contentHash =
+      HashBuilder{spirv_hash}
+          .addBytes(m_entryPointName.data(), m_entryPointName.size())
+          .get();
+
   {
     vk::ShaderModuleCreateInfo shader_module_info{};
     shader_module_info.codeSize = spirv_binary.size() * sizeof(uint32_t);
@@ -0,0 +1,192 @@
+#include "pandora/core/gpu/staging_ring.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "pandora/core/gpu.hpp"
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) {
+  return alignment > 1u ? (value + alignment - 1u) / alignment * alignment
+                        : value;
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+StagingRing::StagingRing(const Context& context,
+                         const TimelineSemaphore& timeline_semaphore,
+                         size_t capacity,
+                         StagingRingPolicy policy)
+    : m_timelineSemaphore(timeline_semaphore),
+      m_policy(policy),
+      m_capacity(capacity) {
+  const auto& limits = context.getPtrDevice()->getLimits();
+  m_minAlignment = std::max(
+      static_cast<size_t>(limits.optimalBufferCopyOffsetAlignment), size_t{4u});
+
+  m_ptrBuffer = std::make_unique<Buffer>(
+      context,
+      MemoryUsage::CpuToGpu,
+      TransferType::TransferSrc,
+      std::vector<BufferUsage>{BufferUsage::StagingBuffer},
+      m_capacity);
+}
+
+StagingRing::~StagingRing() {}
+
+Result<StagingRing::Region> StagingRing::reserve(const Context& context,
+                                                 size_t size,
+                                                 size_t alignment) {
+  if (size == 0u) {
+    return Error::validation("Reservation size must be non-zero")
+        .withContext("StagingRing::reserve");
+  }
+
+  retire(context);
+
+  while (true) {
+    if (const auto offset = tryReserve(size, alignment)) {
+      return Region{*m_ptrBuffer,
+                    offset.value(),
+                    m_ptrBuffer->getMappedSpan().subspan(offset.value(), size)};
+    }
+
+    if (m_policy == StagingRingPolicy::Grow) {
+      grow(context, size + std::max(alignment, m_minAlignment));
+      continue;
+    }
+
+    // Only uncommitted regions (or nothing) stand in the way: waiting on the
+    // timeline would never make room.
+    if (m_segments.empty()) {
+      return Error::runtime("Reservation does not fit in the staging ring")
+          .withContext("StagingRing::reserve");
+    }
+
+    const auto oldest_value = m_segments.front().value;
+    m_timelineSemaphore.get().wait(context, oldest_value);
+    retireUpTo(oldest_value);
+  }
+}
+
+void StagingRing::commit(uint64_t value) {
+  flushUncommitted();
+
+  if (m_uncommittedSize > 0u) {
+    m_segments.push_back(Segment{value, m_head, m_uncommittedSize});
+    m_uncommittedSize = 0u;
+  }
+  m_commitStart = m_head;
+
+  for (auto& retired_buffer : m_retiredBuffers) {
+    if (!retired_buffer.value.has_value()) {
+      retired_buffer.value = value;
+    }
+  }
+}
+
+void StagingRing::retire(const Context& context) {
+  if (m_segments.empty() && m_retiredBuffers.empty()) {
+    return;
+  }
+  retireUpTo(m_timelineSemaphore.get().getCounterValue(context));
+}
+
+std::optional<size_t> StagingRing::tryReserve(size_t size, size_t alignment) {
+  if (m_usedSize == 0u) {
+    m_head = 0u;
+    m_tail = 0u;
+    m_commitStart = 0u;
+  }
+
+  const auto offset = align_up(m_head, std::max(alignment, m_minAlignment));
+
+  size_t placement = 0u;
+  size_t consumed = 0u;
+  if (m_usedSize == 0u || m_head > m_tail) {
+    // Free space is [head, capacity) followed by [0, tail)
+    if (offset + size <= m_capacity) {
+      placement = offset;
+      consumed = offset + size - m_head;
+    } else if (size <= m_tail) {
+      placement = 0u;
+      consumed = m_capacity - m_head + size;
+    } else {
+      return std::nullopt;
+    }
+  } else if (m_head < m_tail && offset + size <= m_tail) {
+    placement = offset;
+    consumed = offset + size - m_head;
+  } else {
+    return std::nullopt;
+  }
+
+  m_head = placement + size;
+  m_usedSize += consumed;
+  m_uncommittedSize += consumed;
+  return placement;
+}
+
+void StagingRing::retireUpTo(uint64_t value) {
+  while (!m_segments.empty() && m_segments.front().value <= value) {
+    m_tail = m_segments.front().end;
+    m_usedSize -= m_segments.front().size;
+    m_segments.pop_front();
+  }
+
+  std::erase_if(m_retiredBuffers, [value](const RetiredBuffer& retired_buffer) {
+    return retired_buffer.value.has_value()
+           && retired_buffer.value.value() <= value;
+  });
+}
+
+void StagingRing::grow(const Context& context, size_t min_size) {
+  flushUncommitted();
+
+  // The old buffer stays alive until the last upload reading it completes
+  if (m_uncommittedSize > 0u) {
+    m_retiredBuffers.push_back(RetiredBuffer{std::move(m_ptrBuffer)});
+  } else if (!m_segments.empty()) {
+    m_retiredBuffers.push_back(
+        RetiredBuffer{std::move(m_ptrBuffer), m_segments.back().value});
+  }
+
+  m_capacity = std::max(m_capacity * 2u, std::bit_ceil(min_size));
+  m_ptrBuffer = std::make_unique<Buffer>(
+      context,
+      MemoryUsage::CpuToGpu,
+      TransferType::TransferSrc,
+      std::vector<BufferUsage>{BufferUsage::StagingBuffer},
+      m_capacity);
+
+  m_segments.clear();
+  m_head = 0u;
+  m_tail = 0u;
+  m_usedSize = 0u;
+  m_uncommittedSize = 0u;
+  m_commitStart = 0u;
+}
+
+void StagingRing::flushUncommitted() const {
+  if (m_uncommittedSize == 0u) {
+    return;
+  }
+
+  if (m_head > m_commitStart) {
+    m_ptrBuffer->flushRange(m_commitStart, m_head - m_commitStart);
+    return;
+  }
+
+  // The uncommitted range wrapped around the end of the ring
+  if (m_commitStart < m_capacity) {
+    m_ptrBuffer->flushRange(m_commitStart, m_capacity - m_commitStart);
+  }
+  if (m_head > 0u) {
+    m_ptrBuffer->flushRange(0u, m_head);
+  }
+}
+
+}  // namespace pandora::core::gpu
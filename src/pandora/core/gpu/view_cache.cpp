@@ -0,0 +1,152 @@
+#include "pandora/core/gpu/view_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
+
+namespace {
+
+/// Expired entries of handles that are never requested again are dropped
+/// once every this many insertions.
+constexpr uint32_t PURGE_INTERVAL = 256u;
+
+uint64_t hash_sampler(const vk::SamplerCreateInfo& info) {
+  return pandora::core::HashBuilder{}
+      .add(info.magFilter)
+      .add(info.minFilter)
+      .add(info.mipmapMode)
+      .add(info.addressModeU)
+      .add(info.addressModeV)
+      .add(info.addressModeW)
+      .add(info.mipLodBias)
+      .add(info.anisotropyEnable)
+      .add(info.maxAnisotropy)
+      .add(info.compareEnable)
+      .add(info.compareOp)
+      .add(info.minLod)
+      .add(info.maxLod)
+      .add(info.borderColor)
+      .add(info.unnormalizedCoordinates)
+      .get();
+}
+
+uint64_t hash_image_view(const vk::ImageViewCreateInfo& info) {
+  const auto& range = info.subresourceRange;
+  return pandora::core::HashBuilder{}
+      .add(std::hash<VkImage>{}(static_cast<VkImage>(info.image)))
+      .add(info.viewType)
+      .add(info.format)
+      .add(info.components.r)
+      .add(info.components.g)
+      .add(info.components.b)
+      .add(info.components.a)
+      .add(range.aspectMask)
+      .add(range.baseMipLevel)
+      .add(range.levelCount)
+      .add(range.baseArrayLayer)
+      .add(range.layerCount)
+      .get();
+}
+
+}  // namespace
+
+namespace pandora::core::gpu {
+
+SamplerCache::SamplerCache(const Device& device)
+    : m_device(device.getPtrLogicalDevice().get()) {}
+
+SamplerCache::~SamplerCache() {}
+
+std::shared_ptr<vk::UniqueSampler> SamplerCache::acquire(
+    const vk::SamplerCreateInfo& create_info) {
+  const auto key = hash_sampler(create_info);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto [first, last] = m_entries.equal_range(key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.create_info == create_info) {
+      if (auto ptr_sampler = it->second.ptr_sampler.lock()) {
+        return ptr_sampler;
+      }
+      m_entries.erase(it);
+      break;
+    }
+  }
+
+  if (++m_insertsSincePurge >= PURGE_INTERVAL) {
+    m_insertsSincePurge = 0u;
+    std::erase_if(m_entries,
+                  [](const auto& entry) {
+                    return entry.second.ptr_sampler.expired();
+                  });
+  }
+
+  auto ptr_sampler = std::make_shared<vk::UniqueSampler>(
+      m_device.createSamplerUnique(create_info));
+  m_entries.emplace(key, Entry{create_info, ptr_sampler});
+  return ptr_sampler;
+}
+
+size_t SamplerCache::getLiveCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<size_t>(
+      std::ranges::count_if(m_entries, [](const auto& entry) {
+        return !entry.second.ptr_sampler.expired();
+      }));
+}
+
+ImageViewCache::ImageViewCache(const Device& device)
+    : m_device(device.getPtrLogicalDevice().get()) {}
+
+ImageViewCache::~ImageViewCache() {}
+
+std::shared_ptr<vk::UniqueImageView> ImageViewCache::acquire(
+    const vk::ImageViewCreateInfo& create_info) {
+  const auto key = hash_image_view(create_info);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const auto [first, last] = m_entries.equal_range(key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.create_info == create_info) {
+      if (auto ptr_image_view = it->second.ptr_image_view.lock()) {
+        return ptr_image_view;
+      }
+      m_entries.erase(it);
+      break;
+    }
+  }
+
+  if (++m_insertsSincePurge >= PURGE_INTERVAL) {
+    m_insertsSincePurge = 0u;
+    std::erase_if(m_entries,
+                  [](const auto& entry) {
+                    return entry.second.ptr_image_view.expired();
+                  });
+  }
+
+  auto ptr_image_view = std::make_shared<vk::UniqueImageView>(
+      m_device.createImageViewUnique(create_info));
+  m_entries.emplace(key, Entry{create_info, ptr_image_view});
+  return ptr_image_view;
+}
+
+void ImageViewCache::purgeImage(vk::Image image) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::erase_if(m_entries, [image](const auto& entry) {
+    return entry.second.create_info.image == image;
+  });
+}
+
+size_t ImageViewCache::getLiveCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<size_t>(
+      std::ranges::count_if(m_entries, [](const auto& entry) {
+        return !entry.second.ptr_image_view.expired();
+      }));
+}
+
+}  // namespace pandora::core::gpu
@@ -21,6 +21,30 @@ vk::MemoryPropertyFlags getMemoryPropertyFlags(
   }
 }
 
+pandora::core::gpu::MemoryTypeRequest getMemoryTypeRequest(
+    pandora::core::MemoryUsage memory_usage) {
+  switch (memory_usage) {
+    using enum pandora::core::MemoryUsage;
+    using enum vk::MemoryPropertyFlagBits;
+
+    case GpuOnly:
+      // Keep host-visible device-local memory (BAR) for uploads
+      return {.required = eDeviceLocal, .avoided = eHostVisible};
+    case CpuOnly:
+      return {.required = eHostVisible | eHostCoherent,
+              .avoided = eDeviceLocal};
+    case CpuToGpu:
+      // Falls back to system memory without a DEVICE_LOCAL|HOST_VISIBLE type
+      return {.required = eHostVisible,
+              .preferred = eDeviceLocal,
+              .avoided = eHostCached};
+    case GpuToCpu:
+      return {.required = eHostVisible, .preferred = eHostCached};
+    default:
+      return {.required = eDeviceLocal};
+  }
+}
+
 vk::AccessFlagBits2 getAccessFlagBits(pandora::core::AccessFlag access_flag) {
   switch (access_flag) {
     using enum pandora::core::AccessFlag;
@@ -1,9 +1,22 @@
 #include <glslang/Public/ShaderLang.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
+#include <glslang/build_info.h>
 
+#include <spirv-tools/libspirv.h>
+#include <spirv-tools/optimizer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <format>
 #include <fstream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #ifdef validation
@@ -17,10 +30,276 @@
 #endif
 
 #include "pandora/core/error.hpp"
+#include "pandora/core/hash.hpp"
 #include "pandora/core/io.hpp"
 
 namespace {
 
+constexpr auto TARGET_SPV_VERSION =
+    glslang::EShTargetLanguageVersion::EShTargetSpv_1_5;
+constexpr auto COMPILE_MESSAGES =
+    static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
+constexpr int32_t DEFAULT_GLSL_VERSION = 100;
+constexpr bool FORWARD_COMPATIBLE = false;
+
+constexpr auto TARGET_ENV = SPV_ENV_VULKAN_1_2;  // Environment of SPIR-V 1.5
+
+constexpr uint32_t CACHE_MAGIC = 0x56505350u;  // "PSPV"
+constexpr uint32_t CACHE_VERSION = 2u;
+constexpr uint64_t DEFAULT_CACHE_SIZE_LIMIT = 64ull * 1024ull * 1024ull;
+
+// Debug instructions removed by strip_debug_info (OpName/OpMemberName stay)
+constexpr uint32_t OP_SOURCE_CONTINUED = 2u;
+constexpr uint32_t OP_SOURCE = 3u;
+constexpr uint32_t OP_SOURCE_EXTENSION = 4u;
+constexpr uint32_t OP_STRING = 7u;
+constexpr uint32_t OP_LINE = 8u;
+constexpr uint32_t OP_NO_LINE = 317u;
+constexpr uint32_t OP_MODULE_PROCESSED = 330u;
+constexpr size_t SPIRV_HEADER_WORDS = 5u;
+
+/// @brief Header written in front of a cached SPIR-V binary
+struct CacheHeader {
+  uint32_t magic = CACHE_MAGIC;
+  uint32_t version = CACHE_VERSION;
+  uint64_t key = 0u;
+  uint64_t word_count = 0u;
+  uint64_t checksum = 0u;
+};
+
+std::filesystem::path default_cache_directory() {
+  std::error_code error_code;
+  const auto temp_directory =
+      std::filesystem::temp_directory_path(error_code);
+  if (error_code) {
+    return {};
+  }
+  return temp_directory / "pandolabo" / "spirv_cache";
+}
+
+struct CacheSettings {
+  std::mutex mutex;
+  std::filesystem::path directory = default_cache_directory();
+  uint64_t size_limit = DEFAULT_CACHE_SIZE_LIMIT;
+};
+
+CacheSettings& cache_settings() {
+  static CacheSettings settings;
+  return settings;
+}
+
+/// @brief Start a cache key with everything the optimization stage depends on
+pandora::core::HashBuilder hash_optimization_stage(
+    const pandora::core::io::shader::CompileOptions& options) {
+  // Optimizer output changes between SPIRV-Tools releases
+  static const std::string spirv_tools_version =
+      spvSoftwareVersionDetailsString();
+
+  return pandora::core::HashBuilder{}
+      .add(CACHE_VERSION)
+      .add(std::span<const char>(spirv_tools_version))
+      .add(TARGET_ENV)
+      .add(options.optimize)
+      .add(options.strip_debug_info);
+}
+
+uint64_t make_cache_key(
+    ::EShLanguage shader_stage,
+    const std::string& shader_code,
+    const pandora::core::io::shader::CompileOptions& options) {
+  return hash_optimization_stage(options)
+      .add(GLSLANG_VERSION_MAJOR)
+      .add(GLSLANG_VERSION_MINOR)
+      .add(GLSLANG_VERSION_PATCH)
+      .add(shader_stage)
+      .add(TARGET_SPV_VERSION)
+      .add(COMPILE_MESSAGES)
+      .add(DEFAULT_GLSL_VERSION)
+      .add(FORWARD_COMPATIBLE)
+      .add(std::span<const char>(shader_code))
+      .get();
+}
+
+/// @brief Key of the optimized form of a precompiled SPIR-V binary
+uint64_t make_binary_cache_key(
+    const std::vector<uint32_t>& shader_binary,
+    const pandora::core::io::shader::CompileOptions& options) {
+  return hash_optimization_stage(options)
+      .add(std::span<const uint32_t>(shader_binary))
+      .get();
+}
+
+/// @brief Drop debug instructions that reflection does not need
+std::vector<uint32_t> strip_debug_instructions(
+    const std::vector<uint32_t>& shader_binary) {
+  if (shader_binary.size() < SPIRV_HEADER_WORDS) {
+    return shader_binary;
+  }
+
+  std::vector<uint32_t> stripped(shader_binary.begin(),
+                                 shader_binary.begin() + SPIRV_HEADER_WORDS);
+  stripped.reserve(shader_binary.size());
+
+  for (size_t offset = SPIRV_HEADER_WORDS; offset < shader_binary.size();) {
+    const auto opcode = shader_binary[offset] & 0xffffu;
+    const auto word_count =
+        std::max<size_t>(shader_binary[offset] >> 16u, 1u);
+    const auto end = std::min(offset + word_count, shader_binary.size());
+
+    switch (opcode) {
+      case OP_SOURCE_CONTINUED:
+      case OP_SOURCE:
+      case OP_SOURCE_EXTENSION:
+      case OP_STRING:
+      case OP_LINE:
+      case OP_NO_LINE:
+      case OP_MODULE_PROCESSED:
+        break;
+      default:
+        stripped.insert(stripped.end(),
+                        shader_binary.begin() + offset,
+                        shader_binary.begin() + end);
+        break;
+    }
+    offset = end;
+  }
+
+  return stripped;
+}
+
+uint64_t compute_checksum(const std::vector<uint32_t>& shader_binary) {
+  return pandora::core::HashBuilder{}
+      .add(std::span<const uint32_t>(shader_binary))
+      .get();
+}
+
+std::filesystem::path cache_entry_path(const std::filesystem::path& directory,
+                                       uint64_t key) {
+  return directory / std::format("{:016x}.spv", key);
+}
+
+/// @brief Read a cached binary, or nothing if the entry is missing or broken
+std::optional<std::vector<uint32_t>> read_cache_entry(
+    const std::filesystem::path& directory, uint64_t key) {
+  const auto entry_path = cache_entry_path(directory, key);
+  std::ifstream file(entry_path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  CacheHeader header{};
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+      || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION
+      || header.key != key) {
+    return std::nullopt;
+  }
+
+  std::error_code error_code;
+  const auto file_size = std::filesystem::file_size(entry_path, error_code);
+  if (error_code
+      || header.word_count * sizeof(uint32_t)
+             != file_size - sizeof(header)) {
+    return std::nullopt;
+  }
+
+  std::vector<uint32_t> shader_binary(
+      static_cast<size_t>(header.word_count));
+  if (!file.read(reinterpret_cast<char*>(shader_binary.data()),
+                 static_cast<std::streamsize>(shader_binary.size()
+                                              * sizeof(uint32_t)))
+      || compute_checksum(shader_binary) != header.checksum) {
+    return std::nullopt;
+  }
+
+  return shader_binary;
+}
+
+/// @brief Store a binary in the cache
+/// @details Best effort: a failed write only costs a recompile next time.
+/// The entry is written to a uniquely named temporary file and renamed, so
+/// readers in other threads or processes never see a partial entry.
+void write_cache_entry(const std::filesystem::path& directory,
+                       uint64_t key,
+                       const std::vector<uint32_t>& shader_binary) {
+  std::error_code error_code;
+  std::filesystem::create_directories(directory, error_code);
+  if (error_code) {
+    return;
+  }
+
+  CacheHeader header{};
+  header.key = key;
+  header.word_count = shader_binary.size();
+  header.checksum = compute_checksum(shader_binary);
+
+  const auto entry_path = cache_entry_path(directory, key);
+  auto temp_path = entry_path;
+  temp_path += std::format(".{:08x}.tmp", std::random_device{}());
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(shader_binary.data()),
+               static_cast<std::streamsize>(shader_binary.size()
+                                            * sizeof(uint32_t)));
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, error_code);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temp_path, entry_path, error_code);
+  if (error_code) {
+    std::filesystem::remove(temp_path, error_code);
+  }
+}
+
+/// @brief Remove the oldest cache files once the directory exceeds its limit
+/// @details Trims to three quarters of the limit, so a full cache is not
+/// rescanned on every write. Files another process removes first are skipped.
+void prune_cache(const std::filesystem::path& directory, uint64_t size_limit) {
+  if (size_limit == 0u) {
+    return;
+  }
+
+  struct CacheFile {
+    std::filesystem::file_time_type write_time;
+    uint64_t size = 0u;
+    std::filesystem::path path;
+  };
+
+  std::error_code error_code;
+  std::vector<CacheFile> files;
+  uint64_t total_size = 0u;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error_code)) {
+    if (!entry.is_regular_file(error_code)) {
+      continue;
+    }
+    const auto size = entry.file_size(error_code);
+    const auto write_time = entry.last_write_time(error_code);
+    if (error_code) {
+      continue;
+    }
+    files.push_back({write_time, size, entry.path()});
+    total_size += size;
+  }
+  if (total_size <= size_limit) {
+    return;
+  }
+
+  std::ranges::sort(files, {}, &CacheFile::write_time);
+  const auto target_size = size_limit / 4u * 3u;
+  for (const auto& file : files) {
+    if (total_size <= target_size) {
+      break;
+    }
+    if (std::filesystem::remove(file.path, error_code)) {
+      total_size -= file.size;
+    }
+  }
+}
+
 ::pandora::core::Error errorValidation(std::string message) {
   return ::pandora::core::Error(::pandora::core::ErrorType::Validation,
                                 std::move(message));
@@ -156,21 +435,83 @@ TBuiltInResource init_t_built_in_resources() {
   return resources;
 }
 
+/// @brief Reference counted, process-wide glslang lifetime
+/// @details glslang builds its built-in symbol tables on first use and frees
+/// them in FinalizeProcess(). The singleton holds a reference of its own, so
+/// the tables survive between compiles and are freed once at exit, after the
+/// last compile has released its reference.
+class GlslangProcess {
+ private:
+  std::mutex m_mutex;
+  uint32_t m_refCount = 0u;
+
+  GlslangProcess() {
+    acquire();
+  }
+
+  ~GlslangProcess() {
+    release();
+  }
+
+ public:
+  GlslangProcess(const GlslangProcess&) = delete;
+  GlslangProcess& operator=(const GlslangProcess&) = delete;
+
+  static GlslangProcess& get() {
+    static GlslangProcess instance;
+    return instance;
+  }
+
+  void acquire() {
+    std::lock_guard lock(m_mutex);
+    if (m_refCount == 0u) {
+      glslang::InitializeProcess();
+    }
+    m_refCount += 1u;
+  }
+
+  void release() {
+    std::lock_guard lock(m_mutex);
+    m_refCount -= 1u;
+    if (m_refCount == 0u) {
+      glslang::FinalizeProcess();
+    }
+  }
+};
+
+/// @brief Keeps glslang initialized while a compile is running
+class GlslangProcessRef {
+ public:
+  GlslangProcessRef() {
+    GlslangProcess::get().acquire();
+  }
+
+  ~GlslangProcessRef() {
+    GlslangProcess::get().release();
+  }
+
+  GlslangProcessRef(const GlslangProcessRef&) = delete;
+  GlslangProcessRef& operator=(const GlslangProcessRef&) = delete;
+};
+
 ::pandora::core::Result<std::vector<uint32_t>> compile_shader(
     const ::EShLanguage& shader_stage, const std::string& shader_code) {
-  glslang::InitializeProcess();
+  const GlslangProcessRef glslang_process{};
 
   std::vector shader_c_strings = {shader_code.data()};
 
   glslang::TShader shader(shader_stage);
   shader.setEnvTarget(glslang::EShTargetLanguage::EShTargetSpv,
-                      glslang::EShTargetLanguageVersion::EShTargetSpv_1_5);
+                      TARGET_SPV_VERSION);
   shader.setStrings(shader_c_strings.data(),
                     static_cast<int32_t>(shader_c_strings.size()));
 
-  EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
+  EShMessages messages = COMPILE_MESSAGES;
   const auto t_built_in_resources = init_t_built_in_resources();
-  if (!shader.parse(&t_built_in_resources, 100, false, messages)) {
+  if (!shader.parse(&t_built_in_resources,
+                    DEFAULT_GLSL_VERSION,
+                    FORWARD_COMPATIBLE,
+                    messages)) {
     return errorValidation(shader_code + "\n" + shader.getInfoLog());
   }
 
@@ -183,7 +524,6 @@ TBuiltInResource init_t_built_in_resources() {
 
   std::vector<uint32_t> shader_binary;
   glslang::GlslangToSpv(*program.getIntermediate(shader_stage), shader_binary);
-  glslang::FinalizeProcess();
 
   return shader_binary;
 }
@@ -192,7 +532,8 @@ TBuiltInResource init_t_built_in_resources() {
 
 namespace pandora::core::io::shader {
 
-Result<std::vector<uint32_t>> readText(const std::string& file_path) {
+Result<std::vector<uint32_t>> readText(const std::string& file_path,
+                                       const CompileOptions& options) {
   PANDORA_TRY_ASSIGN(stage_info, translate_shader_stage(file_path));
   const auto& stage = stage_info.second;
 
@@ -201,11 +542,26 @@ Result<std::vector<uint32_t>> readText(const std::string& file_path) {
     return ::pandora::core::errorIo("Failed to open shader file: " + file_path);
   }
 
-  std::stringstream shader_code{};
-  shader_code << input_file.rdbuf();
+  std::stringstream shader_code_stream{};
+  shader_code_stream << input_file.rdbuf();
   input_file.close();
+  const auto shader_code = shader_code_stream.str();
 
-  return compile_shader(stage, shader_code.str());
+  const auto cache_directory = getCompileCacheDirectory();
+  const auto key = make_cache_key(stage, shader_code, options);
+  if (!cache_directory.empty()) {
+    if (auto cached = read_cache_entry(cache_directory, key)) {
+      return std::move(cached.value());
+    }
+  }
+
+  PANDORA_TRY_ASSIGN(shader_binary, compile_shader(stage, shader_code));
+  auto optimized_binary = optimize(shader_binary, options);
+  if (optimized_binary.isOk() && !cache_directory.empty()) {
+    write_cache_entry(cache_directory, key, optimized_binary.value());
+    prune_cache(cache_directory, getCompileCacheSizeLimit());
+  }
+  return optimized_binary;
 }
 
 Result<std::vector<uint32_t>> readBinary(const std::string& file_path) {
@@ -223,12 +579,111 @@ Result<std::vector<uint32_t>> readBinary(const std::string& file_path) {
   return shader_binary;
 }
 
-Result<std::vector<uint32_t>> read(const std::string& file_path) {
+Result<std::vector<uint32_t>> read(const std::string& file_path,
+                                   const CompileOptions& options) {
   if (file_path.ends_with(".spv")) {
-    return readBinary(file_path);
+    PANDORA_TRY_ASSIGN(shader_binary, readBinary(file_path));
+    // Without optimization the binary is used as is; nothing to cache
+    if (options == CompileOptions{}) {
+      return shader_binary;
+    }
+
+    const auto cache_directory = getCompileCacheDirectory();
+    const auto key = make_binary_cache_key(shader_binary, options);
+    if (!cache_directory.empty()) {
+      if (auto cached = read_cache_entry(cache_directory, key)) {
+        return std::move(cached.value());
+      }
+    }
+
+    auto optimized_binary = optimize(shader_binary, options);
+    if (optimized_binary.isOk() && !cache_directory.empty()) {
+      write_cache_entry(cache_directory, key, optimized_binary.value());
+      prune_cache(cache_directory, getCompileCacheSizeLimit());
+    }
+    return optimized_binary;
   } else {
-    return readText(file_path);
+    return readText(file_path, options);
+  }
+}
+
+std::vector<Result<std::vector<uint32_t>>> compileMany(
+    const std::vector<std::string>& file_paths,
+    uint32_t worker_count,
+    const CompileOptions& options) {
+  if (worker_count == 0u) {
+    worker_count = std::max(std::thread::hardware_concurrency(), 1u);
   }
+  worker_count = std::min(worker_count,
+                          static_cast<uint32_t>(file_paths.size()));
+
+  // Held for the whole batch so glslang is not set up once per file
+  const GlslangProcessRef glslang_process{};
+
+  std::vector<std::optional<Result<std::vector<uint32_t>>>> results(
+      file_paths.size());
+  std::atomic<size_t> next_index = 0u;
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(worker_count);
+    for (uint32_t i = 0u; i < worker_count; i += 1u) {
+      workers.emplace_back([&file_paths, &options, &results, &next_index]() {
+        for (auto index = next_index.fetch_add(1u); index < file_paths.size();
+             index = next_index.fetch_add(1u)) {
+          // An escaping exception would terminate the process via jthread
+          try {
+            results[index] = read(file_paths[index], options);
+          } catch (const std::exception& e) {
+            results[index] = ::pandora::core::Error::runtime(e.what())
+                                 .withContext("io::shader::compileMany");
+          }
+        }
+      });
+    }
+  }
+
+  return results
+         | std::views::transform(
+             [](std::optional<Result<std::vector<uint32_t>>>& x) {
+               return std::move(x.value());
+             })
+         | std::ranges::to<std::vector>();
+}
+
+Result<std::vector<uint32_t>> optimize(
+    const std::vector<uint32_t>& shader_binary, const CompileOptions& options) {
+  if (options == CompileOptions{}) {
+    return shader_binary;
+  }
+
+  std::string messages;
+  spvtools::Optimizer optimizer(TARGET_ENV);
+  optimizer.SetMessageConsumer([&messages](spv_message_level_t level,
+                                           const char*,
+                                           const spv_position_t& position,
+                                           const char* message) {
+    if (level <= SPV_MSG_ERROR) {
+      messages += std::to_string(position.index) + ": " + message + "\n";
+    }
+  });
+
+  if (options.optimize) {
+    optimizer.RegisterPerformancePasses();
+  }
+  if (options.strip_debug_info) {
+    optimizer.RegisterPass(spvtools::CreateStripNonSemanticInfoPass());
+  }
+
+  std::vector<uint32_t> optimized_binary;
+  if (!optimizer.Run(
+          shader_binary.data(), shader_binary.size(), &optimized_binary)) {
+    return errorValidation("SPIR-V optimization failed\n" + messages);
+  }
+
+  if (options.strip_debug_info) {
+    return strip_debug_instructions(optimized_binary);
+  }
+  return optimized_binary;
 }
 
 VoidResult write(const std::string& file_path,
@@ -244,4 +699,28 @@ VoidResult write(const std::string& file_path,
   return ok();
 }
 
+void setCompileCacheDirectory(std::filesystem::path directory) {
+  auto& settings = cache_settings();
+  std::lock_guard lock(settings.mutex);
+  settings.directory = std::move(directory);
+}
+
+std::filesystem::path getCompileCacheDirectory() {
+  auto& settings = cache_settings();
+  std::lock_guard lock(settings.mutex);
+  return settings.directory;
+}
+
+void setCompileCacheSizeLimit(uint64_t size_limit) {
+  auto& settings = cache_settings();
+  std::lock_guard lock(settings.mutex);
+  settings.size_limit = size_limit;
+}
+
+uint64_t getCompileCacheSizeLimit() {
+  auto& settings = cache_settings();
+  std::lock_guard lock(settings.mutex);
+  return settings.size_limit;
+}
+
 }  // namespace pandora::core::io::shader
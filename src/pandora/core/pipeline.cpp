@@ -1,8 +1,11 @@
 #include "pandora/core/pipeline.hpp"
 
+#include <algorithm>
+#include <array>
 #include <ranges>
 
 #include "pandora/core/gpu/vk_helper.hpp"
+#include "pandora/core/hash.hpp"
 #include "pandora/core/renderpass.hpp"
 
 namespace pandora::core {
@@ -162,12 +165,161 @@ void DynamicState::appendState(DynamicOption option) {
   m_info.setDynamicStates(m_states);
 }
 
+uint64_t GraphicInfo::computeHash() const {
+  HashBuilder hash_builder{};
+
+  hash_builder.add(vertex_input.m_bindings.size());
+  for (const auto& binding : vertex_input.m_bindings) {
+    hash_builder.add(binding.binding)
+        .add(binding.stride)
+        .add(binding.inputRate);
+  }
+  hash_builder.add(vertex_input.m_attributes.size());
+  for (const auto& attribute : vertex_input.m_attributes) {
+    hash_builder.add(attribute.location)
+        .add(attribute.binding)
+        .add(attribute.format)
+        .add(attribute.offset);
+  }
+
+  hash_builder.add(input_assembly.m_info.topology)
+      .add(input_assembly.m_info.primitiveRestartEnable)
+      .add(tessellation.m_info.patchControlPoints);
+
+  const auto is_dynamic = [this](vk::DynamicState state) {
+    return std::ranges::contains(dynamic_state.m_states, state);
+  };
+  if (!is_dynamic(vk::DynamicState::eViewport)) {
+    const auto& viewport = viewport_state.m_viewport;
+    hash_builder.add(viewport.x)
+        .add(viewport.y)
+        .add(viewport.width)
+        .add(viewport.height)
+        .add(viewport.minDepth)
+        .add(viewport.maxDepth);
+  }
+  if (!is_dynamic(vk::DynamicState::eScissor)) {
+    const auto& scissor = viewport_state.m_scissor;
+    hash_builder.add(scissor.offset.x)
+        .add(scissor.offset.y)
+        .add(scissor.extent.width)
+        .add(scissor.extent.height);
+  }
+
+  const auto& raster = rasterization.m_info;
+  hash_builder.add(raster.depthClampEnable)
+      .add(raster.rasterizerDiscardEnable)
+      .add(raster.polygonMode)
+      .add(raster.cullMode)
+      .add(raster.frontFace)
+      .add(raster.depthBiasEnable)
+      .add(raster.depthBiasConstantFactor)
+      .add(raster.depthBiasClamp)
+      .add(raster.depthBiasSlopeFactor)
+      .add(raster.lineWidth);
+
+  const auto& multi = multisample.m_info;
+  hash_builder.add(multi.rasterizationSamples)
+      .add(multi.sampleShadingEnable)
+      .add(multi.minSampleShading)
+      .add(multi.alphaToCoverageEnable)
+      .add(multi.alphaToOneEnable);
+
+  const auto add_stencil_op = [&hash_builder](const vk::StencilOpState& op) {
+    hash_builder.add(op.failOp)
+        .add(op.passOp)
+        .add(op.depthFailOp)
+        .add(op.compareOp)
+        .add(op.compareMask)
+        .add(op.writeMask)
+        .add(op.reference);
+  };
+  const auto& depth = depth_stencil.m_info;
+  hash_builder.add(depth.depthTestEnable)
+      .add(depth.depthWriteEnable)
+      .add(depth.depthCompareOp)
+      .add(depth.depthBoundsTestEnable)
+      .add(depth.stencilTestEnable)
+      .add(depth.minDepthBounds)
+      .add(depth.maxDepthBounds);
+  add_stencil_op(depth.front);
+  add_stencil_op(depth.back);
+
+  hash_builder.add(color_blend.m_info.logicOpEnable)
+      .add(color_blend.m_info.logicOp)
+      .add(std::span<const float>(color_blend.m_info.blendConstants));
+  hash_builder.add(color_blend.m_attachments.size());
+  for (const auto& attachment : color_blend.m_attachments) {
+    hash_builder.add(attachment.blendEnable)
+        .add(attachment.srcColorBlendFactor)
+        .add(attachment.dstColorBlendFactor)
+        .add(attachment.colorBlendOp)
+        .add(attachment.srcAlphaBlendFactor)
+        .add(attachment.dstAlphaBlendFactor)
+        .add(attachment.alphaBlendOp)
+        .add(attachment.colorWriteMask);
+  }
+
+  return hash_builder
+      .add(std::span<const vk::DynamicState>(dynamic_state.m_states))
+      .get();
+}
+
 }  // namespace pipeline
 
 Pipeline::Pipeline(const gpu::Context& context,
                    const gpu::DescriptionUnit& description_unit,
                    const gpu::DescriptorSetLayout& descriptor_set_layout,
+                   PipelineBind bind_point)
+    : Pipeline(context,
+               description_unit,
+               std::vector<std::reference_wrapper<
+                   const gpu::DescriptorSetLayout>>{descriptor_set_layout},
+               bind_point) {}
+
+Pipeline::Pipeline(const gpu::Context& context,
+                   const gpu::DescriptionUnit& description_unit,
+                   const std::vector<std::reference_wrapper<
+                       const gpu::DescriptorSetLayout>>& descriptor_set_layouts,
+                   PipelineBind bind_point) {
+  uint32_t set_count = 0u;
+  for (const auto& layout : descriptor_set_layouts) {
+    set_count = std::max(set_count, layout.get().getSetIndex() + 1u);
+  }
+
+  std::vector<vk::DescriptorSetLayout> vk_set_layouts(set_count);
+  for (const auto& layout : descriptor_set_layouts) {
+    vk_set_layouts.at(layout.get().getSetIndex()) =
+        layout.get().getDescriptorSetLayout();
+  }
+
+  // Set indices without a layout still need a valid (empty) one
+  if (std::ranges::contains(vk_set_layouts, vk::DescriptorSetLayout{})) {
+    std::ranges::replace(vk_set_layouts,
+                         vk::DescriptorSetLayout{},
+                         context.getPtrLayoutCache()->getDescriptorSetLayout(
+                             {}));
+  }
+
+  constructPipelineLayout(
+      context, description_unit, vk_set_layouts, bind_point);
+}
+
+Pipeline::Pipeline(const gpu::Context& context,
+                   const gpu::DescriptionUnit& description_unit,
+                   const gpu::BindlessHeap& bindless_heap,
                    PipelineBind bind_point) {
+  constructPipelineLayout(context,
+                          description_unit,
+                          {bindless_heap.getDescriptorSetLayout()},
+                          bind_point);
+}
+
+void Pipeline::constructPipelineLayout(
+    const gpu::Context& context,
+    const gpu::DescriptionUnit& description_unit,
+    const std::vector<vk::DescriptorSetLayout>& descriptor_set_layouts,
+    PipelineBind bind_point) {
   using P = std::ranges::range_value_t<
       decltype(description_unit.getPushConstantRangeMap()
                | std::views::values)>;
@@ -181,11 +333,8 @@ Pipeline::Pipeline(const gpu::Context& context,
         })
       | std::ranges::to<std::vector<vk::PushConstantRange>>();
 
-  m_ptrPipelineLayout =
-      context.getPtrDevice()->getPtrLogicalDevice()->createPipelineLayoutUnique(
-          vk::PipelineLayoutCreateInfo{}
-              .setSetLayouts(descriptor_set_layout.getDescriptorSetLayout())
-              .setPushConstantRanges(push_constant_ranges));
+  m_pipelineLayout = context.getPtrLayoutCache()->getPipelineLayout(
+      descriptor_set_layouts, push_constant_ranges);
 
   m_bindPoint = vk_helper::getPipelineBindPoint(bind_point);
 }
@@ -194,21 +343,8 @@ Pipeline::~Pipeline() {}
 
 void Pipeline::constructComputePipeline(
     const gpu::Context& context, const gpu::ShaderModule& shader_module) {
-  m_queueFamilyType = QueueFamilyType::Compute;
-
-  const auto compute_pipeline_info =
-      vk::ComputePipelineCreateInfo{}
-          .setLayout(m_ptrPipelineLayout.get())
-          .setStage(vk::PipelineShaderStageCreateInfo{}
-                        .setStage(vk::ShaderStageFlagBits::eCompute)
-                        .setModule(shader_module.getModule())
-                        .setPName(shader_module.getEntryPointName().c_str()));
-
-  m_ptrPipeline =
-      context.getPtrDevice()
-          ->getPtrLogicalDevice()
-          ->createComputePipelineUnique(nullptr, compute_pipeline_info)
-          .value;
+  const std::array targets{ComputePipelineTarget{*this, shader_module}};
+  constructComputePipelines(context, targets);
 }
 
 void Pipeline::constructGraphicsPipeline(
@@ -218,58 +354,135 @@ void Pipeline::constructGraphicsPipeline(
     pipeline::GraphicInfo& graphic_info,
     const Renderpass& render_pass,
     uint32_t subpass_index) {
-  m_queueFamilyType = QueueFamilyType::Graphics;
-  vk::GraphicsPipelineCreateInfo pipeline_info{};
-
-  using M = std::ranges::range_value_t<decltype(module_keys)>;
-  const auto shader_stage_infos =
-      module_keys | std::views::transform([&shader_module_map](const M& x) {
-        const auto& shader_module = shader_module_map.at(x);
-
-        return vk::PipelineShaderStageCreateInfo{}
-            .setStage(shader_module.getShaderStageFlag())
-            .setModule(shader_module.getModule())
-            .setPName(shader_module.getEntryPointName().c_str());
+  const std::array targets{GraphicsPipelineTarget{*this,
+                                                  shader_module_map,
+                                                  module_keys,
+                                                  graphic_info,
+                                                  render_pass,
+                                                  subpass_index}};
+  constructGraphicsPipelines(context, targets);
+}
+
+void Pipeline::constructComputePipelines(
+    const gpu::Context& context,
+    std::span<const ComputePipelineTarget> targets) {
+  if (targets.empty()) {
+    return;
+  }
+
+  const auto compute_pipeline_infos =
+      targets | std::views::transform([](const ComputePipelineTarget& x) {
+        return vk::ComputePipelineCreateInfo{}
+            .setLayout(x.pipeline.m_pipelineLayout)
+            .setStage(
+                vk::PipelineShaderStageCreateInfo{}
+                    .setStage(vk::ShaderStageFlagBits::eCompute)
+                    .setModule(x.shader_module.getModule())
+                    .setPName(x.shader_module.getEntryPointName().c_str()));
       })
-      | std::ranges::to<std::vector<vk::PipelineShaderStageCreateInfo>>();
+      | std::ranges::to<std::vector<vk::ComputePipelineCreateInfo>>();
 
-  {
-    auto& vertex_input = graphic_info.vertex_input;
-    vertex_input.m_info.setVertexBindingDescriptions(vertex_input.m_bindings)
-        .setVertexAttributeDescriptions(vertex_input.m_attributes);
+  auto ptr_pipelines =
+      context.getPtrDevice()
+          ->getPtrLogicalDevice()
+          ->createComputePipelinesUnique(
+              context.getPtrPipelineCacheStore()->getPipelineCache(),
+              compute_pipeline_infos)
+          .value;
 
-    pipeline_info.setPVertexInputState(&(vertex_input.m_info));
+  for (auto&& [target, ptr_pipeline] :
+       std::views::zip(targets, ptr_pipelines)) {
+    auto& pipeline = target.pipeline;
+    pipeline.m_queueFamilyType = QueueFamilyType::Compute;
+    pipeline.m_ptrPipeline = std::move(ptr_pipeline);
+    pipeline.m_trackingToken =
+        gpu::TrackedResourceToken(context.getPtrResourceTracker().get(),
+                                  gpu::TrackedResource::Pipeline);
   }
+}
 
-  {
-    auto& color_blend = graphic_info.color_blend;
-    color_blend.m_info.setAttachments(color_blend.m_attachments);
+void Pipeline::constructGraphicsPipelines(
+    const gpu::Context& context,
+    std::span<const GraphicsPipelineTarget> targets) {
+  if (targets.empty()) {
+    return;
+  }
 
-    pipeline_info.setPColorBlendState(&(color_blend.m_info));
+  // Create infos point into these, so they are reserved up front and the
+  // caller's GraphicInfo is never patched (it may be shared across threads)
+  struct ArrayStates {
+    std::vector<vk::PipelineShaderStageCreateInfo> shader_stages;
+    vk::PipelineVertexInputStateCreateInfo vertex_input;
+    vk::PipelineColorBlendStateCreateInfo color_blend;
+    vk::PipelineDynamicStateCreateInfo dynamic_state;
+  };
+  std::vector<ArrayStates> array_states_list;
+  array_states_list.reserve(targets.size());
+  std::vector<vk::GraphicsPipelineCreateInfo> pipeline_infos;
+  pipeline_infos.reserve(targets.size());
+
+  for (const auto& target : targets) {
+    using M = std::ranges::range_value_t<decltype(target.module_keys)>;
+    const auto& shader_module_map = target.shader_module_map;
+    const auto& graphic_info = target.graphic_info;
+
+    auto& array_states = array_states_list.emplace_back(ArrayStates{
+        target.module_keys
+            | std::views::transform([&shader_module_map](const M& x) {
+                const auto& shader_module = shader_module_map.at(x);
+
+                return vk::PipelineShaderStageCreateInfo{}
+                    .setStage(shader_module.getShaderStageFlag())
+                    .setModule(shader_module.getModule())
+                    .setPName(shader_module.getEntryPointName().c_str());
+              })
+            | std::ranges::to<std::vector<vk::PipelineShaderStageCreateInfo>>(),
+        graphic_info.vertex_input.m_info,
+        graphic_info.color_blend.m_info,
+        graphic_info.dynamic_state.m_info});
+
+    array_states.vertex_input
+        .setVertexBindingDescriptions(graphic_info.vertex_input.m_bindings)
+        .setVertexAttributeDescriptions(graphic_info.vertex_input.m_attributes);
+    array_states.color_blend.setAttachments(
+        graphic_info.color_blend.m_attachments);
+    array_states.dynamic_state.setDynamicStates(
+        graphic_info.dynamic_state.m_states);
+
+    pipeline_infos.push_back(
+        vk::GraphicsPipelineCreateInfo{}
+            .setStages(array_states.shader_stages)
+            .setPVertexInputState(&(array_states.vertex_input))
+            .setPInputAssemblyState(&(graphic_info.input_assembly.m_info))
+            .setPTessellationState(&(graphic_info.tessellation.m_info))
+            .setPViewportState(&(graphic_info.viewport_state.m_info))
+            .setPRasterizationState(&(graphic_info.rasterization.m_info))
+            .setPMultisampleState(&(graphic_info.multisample.m_info))
+            .setPDepthStencilState(&(graphic_info.depth_stencil.m_info))
+            .setPColorBlendState(&(array_states.color_blend))
+            .setPDynamicState(&(array_states.dynamic_state))
+            .setLayout(target.pipeline.m_pipelineLayout)
+            .setRenderPass(target.render_pass.getRenderPass())
+            .setSubpass(target.subpass_index));
   }
 
-  {
-    auto& dynamic_state = graphic_info.dynamic_state;
-    dynamic_state.m_info.setDynamicStates(dynamic_state.m_states);
+  auto ptr_pipelines =
+      context.getPtrDevice()
+          ->getPtrLogicalDevice()
+          ->createGraphicsPipelinesUnique(
+              context.getPtrPipelineCacheStore()->getPipelineCache(),
+              pipeline_infos)
+          .value;
 
-    pipeline_info.setPDynamicState(&(dynamic_state.m_info));
+  for (auto&& [target, ptr_pipeline] :
+       std::views::zip(targets, ptr_pipelines)) {
+    auto& pipeline = target.pipeline;
+    pipeline.m_queueFamilyType = QueueFamilyType::Graphics;
+    pipeline.m_ptrPipeline = std::move(ptr_pipeline);
+    pipeline.m_trackingToken =
+        gpu::TrackedResourceToken(context.getPtrResourceTracker().get(),
+                                  gpu::TrackedResource::Pipeline);
   }
-
-  pipeline_info.setStages(shader_stage_infos)
-      .setPInputAssemblyState(&(graphic_info.input_assembly.m_info))
-      .setPTessellationState(&(graphic_info.tessellation.m_info))
-      .setPViewportState(&(graphic_info.viewport_state.m_info))
-      .setPRasterizationState(&(graphic_info.rasterization.m_info))
-      .setPMultisampleState(&(graphic_info.multisample.m_info))
-      .setPDepthStencilState(&(graphic_info.depth_stencil.m_info))
-      .setLayout(m_ptrPipelineLayout.get())
-      .setRenderPass(render_pass.getRenderPass())
-      .setSubpass(subpass_index);
-
-  m_ptrPipeline = context.getPtrDevice()
-                      ->getPtrLogicalDevice()
-                      ->createGraphicsPipelineUnique(nullptr, pipeline_info)
-                      .value;
 }
 
 }  // namespace pandora::core
@@ -1,6 +1,69 @@
 #include "pandora/core/renderpass.hpp"
 
+#include <span>
+
 #include "pandora/core/gpu/vk_helper.hpp"
+#include "pandora/core/hash.hpp"
+
+namespace {
+
+void add_attachment_references(
+    pandora::core::HashBuilder& hash_builder,
+    const vk::AttachmentReference* references,
+    uint32_t count) {
+  hash_builder.add(count);
+  for (uint32_t i = 0u; references && i < count; i += 1u) {
+    hash_builder.add(references[i].attachment);
+  }
+}
+
+uint64_t compute_compatibility_hash(
+    const pandora::core::AttachmentList& attachment_list,
+    const pandora::core::SubpassGraph& subpass_graph) {
+  pandora::core::HashBuilder hash_builder{};
+
+  hash_builder.add(attachment_list.getDescriptions().size());
+  for (const auto& description : attachment_list.getDescriptions()) {
+    hash_builder.add(description.flags)
+        .add(description.format)
+        .add(description.samples);
+  }
+
+  hash_builder.add(subpass_graph.getDescriptions().size());
+  for (const auto& subpass : subpass_graph.getDescriptions()) {
+    hash_builder.add(subpass.flags).add(subpass.pipelineBindPoint);
+    add_attachment_references(
+        hash_builder, subpass.pInputAttachments, subpass.inputAttachmentCount);
+    add_attachment_references(
+        hash_builder, subpass.pColorAttachments, subpass.colorAttachmentCount);
+    add_attachment_references(hash_builder,
+                              subpass.pResolveAttachments,
+                              subpass.pResolveAttachments
+                                  ? subpass.colorAttachmentCount
+                                  : 0u);
+    add_attachment_references(hash_builder,
+                              subpass.pDepthStencilAttachment,
+                              subpass.pDepthStencilAttachment ? 1u : 0u);
+    hash_builder.add(std::span<const uint32_t>(
+        subpass.pPreserveAttachments,
+        subpass.pPreserveAttachments ? subpass.preserveAttachmentCount : 0u));
+  }
+
+  hash_builder.add(subpass_graph.getDependencies().size());
+  for (const auto& dependency : subpass_graph.getDependencies()) {
+    hash_builder.add(dependency.srcSubpass)
+        .add(dependency.dstSubpass)
+        .add(dependency.srcStageMask)
+        .add(dependency.dstStageMask)
+        .add(dependency.srcAccessMask)
+        .add(dependency.dstAccessMask)
+        .add(dependency.dependencyFlags);
+  }
+
+  return hash_builder.get();
+}
+
+}  // namespace
 
 namespace pandora::core {
 
@@ -13,6 +76,8 @@ Renderpass::Renderpass(const gpu::Context& context,
               .setAttachments(attachment_list.getDescriptions())
               .setSubpasses(subpass_graph.getDescriptions())
               .setDependencies(subpass_graph.getDependencies()));
+  m_compatibilityHash =
+      compute_compatibility_hash(attachment_list, subpass_graph);
 }
 
 Renderpass::~Renderpass() {}
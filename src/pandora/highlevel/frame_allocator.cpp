@@ -0,0 +1,101 @@
+#include "pandora/highlevel/frame_allocator.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) {
+  return alignment > 1u ? (value + alignment - 1u) / alignment * alignment
+                        : value;
+}
+
+}  // namespace
+
+namespace pandora::highlevel {
+
+FrameAllocator::FrameAllocator(
+    const pandora::core::gpu::Context& context,
+    size_t capacity,
+    uint32_t frame_count,
+    const std::vector<pandora::core::BufferUsage>& buffer_usages)
+    : m_contextOwner(context),
+      m_bufferUsages(buffer_usages),
+      m_capacity(capacity) {
+  if (!context.isInitialized()) {
+    return;
+  }
+
+  const auto& limits = context.getPtrDevice()->getLimits();
+  m_minAlignment =
+      static_cast<size_t>(std::max({limits.minUniformBufferOffsetAlignment,
+                                    limits.minStorageBufferOffsetAlignment,
+                                    vk::DeviceSize{4u}}));
+
+  m_frameBuffers.reserve(frame_count);
+  for (uint32_t idx = 0u; idx < frame_count; idx += 1u) {
+    ensureFrameBuffer(idx);
+  }
+}
+
+const pandora::core::gpu::Buffer& FrameAllocator::ensureFrameBuffer(
+    uint32_t frame_index) {
+  while (m_frameBuffers.size() <= frame_index) {
+    m_frameBuffers.push_back(std::make_unique<pandora::core::gpu::Buffer>(
+        m_contextOwner.get(),
+        pandora::core::MemoryUsage::CpuToGpu,
+        pandora::core::TransferType::TransferDst,
+        m_bufferUsages,
+        m_capacity));
+  }
+  return *m_frameBuffers.at(frame_index);
+}
+
+void FrameAllocator::reset(uint32_t frame_index) {
+  if (!m_contextOwner.get().isInitialized()) {
+    return;
+  }
+
+  ensureFrameBuffer(frame_index);
+  m_frameIndex = frame_index;
+  m_head = 0u;
+}
+
+pandora::core::Result<FrameAllocator::Allocation> FrameAllocator::allocate(
+    size_t size, size_t alignment) {
+  if (m_frameBuffers.empty()) {
+    return pandora::core::Error::runtime("Context not initialized")
+        .withContext("FrameAllocator::allocate");
+  }
+
+  const auto offset =
+      align_up(m_head, std::max(alignment, m_minAlignment));
+  if (size == 0u || offset + size > m_capacity) {
+    return pandora::core::Error::runtime(
+               "Frame allocation exceeds per-frame capacity")
+        .withContext("FrameAllocator::allocate");
+  }
+
+  m_head = offset + size;
+
+  const auto& buffer = *m_frameBuffers.at(m_frameIndex);
+  return Allocation{buffer,
+                    static_cast<uint32_t>(offset),
+                    buffer.getMappedSpan().subspan(offset, size)};
+}
+
+pandora::core::Result<FrameAllocator::Allocation> FrameAllocator::push(
+    std::span<const std::byte> data, size_t alignment) {
+  PANDORA_TRY_ASSIGN(allocation, allocate(data.size_bytes(), alignment));
+  std::memcpy(allocation.data.data(), data.data(), data.size_bytes());
+  return allocation;
+}
+
+void FrameAllocator::flush() const {
+  if (m_frameBuffers.empty() || m_head == 0u) {
+    return;
+  }
+  m_frameBuffers.at(m_frameIndex)->flushRange(0u, m_head);
+}
+
+}  // namespace pandora::highlevel
@@ -1,17 +1,211 @@
 #include "pandora/highlevel/pipeline_cache.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <tuple>
+
+#include "pandora/core/gpu.hpp"
+#include "pandora/core/hash.hpp"
+#include "pandora/core/renderpass.hpp"
+
+namespace {
+
+/// @brief Collect key parts while hashing them
+class KeyBuilder {
+ private:
+  pandora::core::HashBuilder m_hashBuilder;
+  std::vector<uint64_t> m_parts;
+
+ public:
+  KeyBuilder& add(uint64_t part) {
+    m_hashBuilder.add(part);
+    m_parts.push_back(part);
+    return *this;
+  }
+
+  pandora::highlevel::PipelineCache::Key build() const {
+    return {m_hashBuilder.get(), m_parts};
+  }
+};
+
+/// @brief Start a key with the pipeline layout state
+KeyBuilder build_layout_key(
+    const pandora::core::gpu::DescriptionUnit& description_unit,
+    const pandora::highlevel::PipelineCache::SetLayoutList&
+        descriptor_set_layouts,
+    pandora::core::PipelineBind bind_point) {
+  KeyBuilder key_builder{};
+  key_builder.add(static_cast<uint64_t>(bind_point));
+
+  // Layout handles come from the context's LayoutCache, so equal handles
+  // mean equal contents
+  auto set_layouts = descriptor_set_layouts
+                     | std::views::transform([](const auto& layout) {
+                         return std::tuple(
+                             layout.get().getSetIndex(),
+                             static_cast<VkDescriptorSetLayout>(
+                                 layout.get().getDescriptorSetLayout()));
+                       })
+                     | std::ranges::to<std::vector>();
+  std::ranges::sort(set_layouts);
+  key_builder.add(set_layouts.size());
+  for (const auto& [set_index, set_layout] : set_layouts) {
+    key_builder.add(set_index).add(std::bit_cast<uint64_t>(set_layout));
+  }
+
+  auto push_constant_ranges =
+      description_unit.getPushConstantRangeMap() | std::views::values
+      | std::views::transform([](const pandora::core::PushConstantRange& x) {
+          return std::tuple(x.offset,
+                            x.size,
+                            static_cast<VkShaderStageFlags>(x.stage_flags));
+        })
+      | std::ranges::to<std::vector>();
+  std::ranges::sort(push_constant_ranges);
+  key_builder.add(push_constant_ranges.size());
+  for (const auto& [offset, size, stage_flags] : push_constant_ranges) {
+    key_builder.add(offset).add(size).add(stage_flags);
+  }
+
+  return key_builder;
+}
+
+}  // namespace
+
 namespace pandora::highlevel {
 
 pandora::core::Pipeline& PipelineCache::getOrCreate(
-    const std::string& key, const PipelineBuilder& builder) {
-  if (auto it = m_cache.find(key); it != m_cache.end()) {
-    return *it->second;
+    const Key& key,
+    const PipelineBuilder& builder,
+    std::vector<uint64_t> shader_hashes) {
+  const auto [first, last] = m_cache.equal_range(key.hash);
+  for (auto it = first; it != last; ++it) {
+    if (it->second.key_parts == key.parts) {
+      return *it->second.ptr_pipeline;
+    }
   }
 
   auto created = builder(m_contextOwner.get());
   auto& ref = *created;
-  m_cache.emplace(key, std::move(created));
+  m_cache.emplace(
+      key.hash,
+      Entry{key.parts, std::move(created), std::move(shader_hashes)});
   return ref;
 }
 
+pandora::core::Pipeline& PipelineCache::getOrCreate(
+    uint64_t key,
+    const PipelineBuilder& builder,
+    std::vector<uint64_t> shader_hashes) {
+  return getOrCreate(Key{key, {key}}, builder, std::move(shader_hashes));
+}
+
+pandora::core::Pipeline& PipelineCache::getOrCreateCompute(
+    const pandora::core::gpu::DescriptionUnit& description_unit,
+    const SetLayoutList& descriptor_set_layouts,
+    const pandora::core::gpu::ShaderModule& shader_module) {
+  return getOrCreate(
+      makeComputeKey(description_unit, descriptor_set_layouts, shader_module),
+      [&](const pandora::core::gpu::Context& context) {
+        auto pipeline = std::make_unique<pandora::core::Pipeline>(
+            context,
+            description_unit,
+            descriptor_set_layouts,
+            pandora::core::PipelineBind::Compute);
+        pipeline->constructComputePipeline(context, shader_module);
+        return pipeline;
+      },
+      {shader_module.getContentHash()});
+}
+
+pandora::core::Pipeline& PipelineCache::getOrCreateGraphics(
+    const pandora::core::gpu::DescriptionUnit& description_unit,
+    const SetLayoutList& descriptor_set_layouts,
+    const std::unordered_map<std::string, pandora::core::gpu::ShaderModule>&
+        shader_module_map,
+    const std::vector<std::string>& module_keys,
+    pandora::core::pipeline::GraphicInfo& graphic_info,
+    const pandora::core::Renderpass& render_pass,
+    uint32_t subpass_index) {
+  return getOrCreate(
+      makeGraphicsKey(description_unit,
+                      descriptor_set_layouts,
+                      shader_module_map,
+                      module_keys,
+                      graphic_info,
+                      render_pass,
+                      subpass_index),
+      [&](const pandora::core::gpu::Context& context) {
+        auto pipeline = std::make_unique<pandora::core::Pipeline>(
+            context,
+            description_unit,
+            descriptor_set_layouts,
+            pandora::core::PipelineBind::Graphics);
+        pipeline->constructGraphicsPipeline(context,
+                                            shader_module_map,
+                                            module_keys,
+                                            graphic_info,
+                                            render_pass,
+                                            subpass_index);
+        return pipeline;
+      },
+      module_keys | std::views::transform([&](const std::string& x) {
+        return shader_module_map.at(x).getContentHash();
+      }) | std::ranges::to<std::vector>());
+}
+
+std::vector<std::unique_ptr<pandora::core::Pipeline>>
+PipelineCache::evictShader(uint64_t shader_content_hash) {
+  std::vector<std::unique_ptr<pandora::core::Pipeline>> evicted;
+  std::erase_if(m_cache, [&](auto& key_entry) {
+    auto& entry = key_entry.second;
+    if (!std::ranges::contains(entry.shader_hashes, shader_content_hash)) {
+      return false;
+    }
+    evicted.push_back(std::move(entry.ptr_pipeline));
+    return true;
+  });
+  return evicted;
+}
+
+PipelineCache::Key PipelineCache::makeComputeKey(
+    const pandora::core::gpu::DescriptionUnit& description_unit,
+    const SetLayoutList& descriptor_set_layouts,
+    const pandora::core::gpu::ShaderModule& shader_module) {
+  return build_layout_key(description_unit,
+                          descriptor_set_layouts,
+                          pandora::core::PipelineBind::Compute)
+      .add(shader_module.getContentHash())
+      .build();
+}
+
+PipelineCache::Key PipelineCache::makeGraphicsKey(
+    const pandora::core::gpu::DescriptionUnit& description_unit,
+    const SetLayoutList& descriptor_set_layouts,
+    const std::unordered_map<std::string, pandora::core::gpu::ShaderModule>&
+        shader_module_map,
+    const std::vector<std::string>& module_keys,
+    const pandora::core::pipeline::GraphicInfo& graphic_info,
+    const pandora::core::Renderpass& render_pass,
+    uint32_t subpass_index) {
+  auto key_builder = build_layout_key(description_unit,
+                                      descriptor_set_layouts,
+                                      pandora::core::PipelineBind::Graphics);
+
+  key_builder.add(module_keys.size());
+  for (const auto& module_key : module_keys) {
+    const auto& shader_module = shader_module_map.at(module_key);
+    key_builder
+        .add(static_cast<VkShaderStageFlags>(
+            shader_module.getShaderStageFlag()))
+        .add(shader_module.getContentHash());
+  }
+
+  return key_builder.add(graphic_info.computeHash())
+      .add(render_pass.getCompatibilityHash())
+      .add(subpass_index)
+      .build();
+}
+
 }  // namespace pandora::highlevel
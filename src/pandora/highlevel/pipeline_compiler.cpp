@@ -0,0 +1,197 @@
+#include "pandora/highlevel/pipeline_compiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "pandora/core/gpu.hpp"
+
+namespace {
+
+/// @brief State shared by every chunk of one batch
+template <typename Target>
+struct BatchState {
+  std::vector<Target> targets;
+  std::atomic<size_t> remaining_chunks = 0u;
+  std::mutex error_mutex;
+  std::optional<pandora::core::Error> first_error;
+  std::promise<pandora::core::VoidResult> promise;
+  pandora::highlevel::PipelineCompiler::CompletionFn on_complete;
+};
+
+/// @brief Run the completion callback and make the batch future ready
+/// @details A throwing callback must not leave the future without a value; its
+/// exception is reported through the future unless the batch already failed.
+template <typename Target>
+void finish_batch(BatchState<Target>& state,
+                  pandora::core::VoidResult result,
+                  const char* name) {
+  if (state.on_complete) {
+    try {
+      state.on_complete(result);
+    } catch (const std::exception& e) {
+      if (result.isOk()) {
+        result = pandora::core::Error::runtime(e.what()).withContext(name);
+      }
+    } catch (...) {
+      if (result.isOk()) {
+        result = pandora::core::Error::runtime("Completion callback threw")
+                     .withContext(name);
+      }
+    }
+  }
+  state.promise.set_value(std::move(result));
+}
+
+void construct_pipelines(
+    const pandora::core::gpu::Context& context,
+    std::span<const pandora::highlevel::PipelineCompiler::ComputeTarget>
+        targets) {
+  pandora::core::Pipeline::constructComputePipelines(context, targets);
+}
+
+void construct_pipelines(
+    const pandora::core::gpu::Context& context,
+    std::span<const pandora::highlevel::PipelineCompiler::GraphicsTarget>
+        targets) {
+  pandora::core::Pipeline::constructGraphicsPipelines(context, targets);
+}
+
+}  // namespace
+
+namespace pandora::highlevel {
+
+PipelineCompiler::PipelineCompiler(const pandora::core::gpu::Context& context,
+                                   uint32_t worker_count,
+                                   uint32_t chunk_size)
+    : m_contextOwner(context), m_chunkSize(std::max(chunk_size, 1u)) {
+  if (worker_count == 0u) {
+    worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  m_workers.reserve(worker_count);
+  for (uint32_t i = 0u; i < worker_count; i += 1u) {
+    m_workers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+PipelineCompiler::~PipelineCompiler() {
+  {
+    std::lock_guard lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_condition.notify_all();
+
+  // Queued chunks are drained before the workers exit, so no future is left
+  // without a value
+  m_workers.clear();
+}
+
+void PipelineCompiler::enqueue(std::vector<std::function<void()>> tasks) {
+  {
+    std::lock_guard lock(m_mutex);
+    for (auto& task : tasks) {
+      m_tasks.push_back(std::move(task));
+    }
+  }
+  m_condition.notify_all();
+}
+
+void PipelineCompiler::workerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock lock(m_mutex);
+      m_condition.wait(lock,
+                       [this]() { return m_isStopping || !m_tasks.empty(); });
+      if (m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+    task();
+  }
+}
+
+template <typename Target>
+std::future<pandora::core::VoidResult> PipelineCompiler::dispatch(
+    std::vector<Target> targets, CompletionFn on_complete, const char* name) {
+  auto ptr_state = std::make_shared<BatchState<Target>>();
+  ptr_state->targets = std::move(targets);
+  ptr_state->on_complete = std::move(on_complete);
+  auto future = ptr_state->promise.get_future();
+
+  const auto target_count = ptr_state->targets.size();
+  if (target_count == 0u) {
+    finish_batch(*ptr_state, pandora::core::ok(), name);
+    return future;
+  }
+
+  // Spread small batches over every worker, but never exceed the chunk size
+  const auto worker_count = static_cast<size_t>(m_workers.size());
+  const auto chunk_size = std::clamp<size_t>(
+      (target_count + worker_count - 1u) / worker_count, 1u, m_chunkSize);
+  const auto chunk_count = (target_count + chunk_size - 1u) / chunk_size;
+  ptr_state->remaining_chunks = chunk_count;
+
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(chunk_count);
+  for (size_t offset = 0u; offset < target_count; offset += chunk_size) {
+    const auto count = std::min(chunk_size, target_count - offset);
+
+    tasks.push_back([this, ptr_state, offset, count, name]() {
+      const auto chunk =
+          std::span<const Target>(ptr_state->targets).subspan(offset, count);
+
+      std::optional<pandora::core::Error> error;
+      try {
+        construct_pipelines(m_contextOwner.get(), chunk);
+      } catch (const vk::SystemError& e) {
+        error = pandora::core::Error::gpu(e.what()).withContext(name);
+      } catch (const std::exception& e) {
+        error = pandora::core::Error::runtime(e.what()).withContext(name);
+      }
+
+      if (error.has_value()) {
+        std::lock_guard lock(ptr_state->error_mutex);
+        if (!ptr_state->first_error.has_value()) {
+          ptr_state->first_error = std::move(error);
+        }
+      }
+
+      if (ptr_state->remaining_chunks.fetch_sub(1u) != 1u) {
+        return;
+      }
+
+      // Last chunk of the batch; other chunks have published their errors
+      auto result =
+          ptr_state->first_error.has_value()
+              ? pandora::core::VoidResult(ptr_state->first_error.value())
+              : pandora::core::ok();
+      finish_batch(*ptr_state, std::move(result), name);
+    });
+  }
+
+  enqueue(std::move(tasks));
+  return future;
+}
+
+std::future<pandora::core::VoidResult> PipelineCompiler::compileCompute(
+    std::vector<ComputeTarget> targets, CompletionFn on_complete) {
+  return dispatch(std::move(targets),
+                  std::move(on_complete),
+                  "PipelineCompiler::compileCompute");
+}
+
+std::future<pandora::core::VoidResult> PipelineCompiler::compileGraphics(
+    std::vector<GraphicsTarget> targets, CompletionFn on_complete) {
+  return dispatch(std::move(targets),
+                  std::move(on_complete),
+                  "PipelineCompiler::compileGraphics");
+}
+
+}  // namespace pandora::highlevel
@@ -53,6 +53,14 @@ pandora::core::Result<FrameContext> Renderer::beginFrame() {
   auto& driver = *m_graphicDrivers.at(frame_index);
   driver.resetAllCommandPools(context);
 
+  // The frame fence has been waited on in updateImageIndex, so the GPU no
+  // longer reads this frame's transient data.
+  if (m_frameAllocator.has_value()) {
+    m_frameAllocator->get().reset(frame_index);
+  }
+  context.getPtrDeletionQueue()->collect();
+  context.getPtrAllocator()->markFrame();
+
   return FrameContext{image_index, frame_index, driver};
 }
 
@@ -103,6 +111,10 @@ pandora::core::VoidResult Renderer::endFrame(FrameContext& frame) {
   const auto finished_semaphore = ptr_swapchain->getFinishedSemaphore();
   const auto finished_fence = ptr_swapchain->getFence();
 
+  if (m_frameAllocator.has_value()) {
+    m_frameAllocator->get().flush();
+  }
+
   auto wait_semaphores = frame.extraWaitSemaphores;
   wait_semaphores.push_back(
       pandora::core::SubmitSemaphore{}
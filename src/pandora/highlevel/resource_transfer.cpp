@@ -1,24 +1,33 @@
 #include "pandora/highlevel/resource_transfer.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace {
 
-void writeToStagingBuffer(pandora::core::gpu::Buffer& staging,
-                          const pandora::core::gpu::Context& context,
-                          std::span<const std::byte> data) {
-  auto* mapped = staging.mapMemory(context);
-  std::memcpy(mapped, data.data(), data.size_bytes());
-  staging.unmapMemory(context);
+void writeToMappedBuffer(const pandora::core::gpu::Buffer& buffer,
+                         std::span<const std::byte> data,
+                         size_t offset = 0u) {
+  std::memcpy(buffer.getMappedSpan().data() + offset,
+              data.data(),
+              data.size_bytes());
+  buffer.flushRange(offset, data.size_bytes());
+}
+
+// Destinations in host-visible device-local memory skip the staging copy
+bool canWriteDirectly(const pandora::core::gpu::Context& context,
+                      const pandora::core::gpu::Buffer& dst) {
+  return dst.isPersistentlyMapped() && context.getPtrAllocator()
+         && context.getPtrAllocator()->isDirectWriteAvailable();
 }
 
 void readFromStagingBuffer(const pandora::core::gpu::Buffer& staging,
-                           const pandora::core::gpu::Context& context,
                            std::span<std::byte> out) {
-  const auto* mapped = staging.mapMemory(context);
-  std::memcpy(out.data(), mapped, out.size_bytes());
-  staging.unmapMemory(context);
+  staging.invalidateRange(0u, out.size_bytes());
+  std::memcpy(out.data(), staging.getMappedSpan().data(), out.size_bytes());
 }
 
 template <typename RecordFn>
@@ -188,6 +197,18 @@ TransferPlan& TransferPlan::copyBuffer(const pandora::core::gpu::Buffer& src,
   return *this;
 }
 
+TransferPlan& TransferPlan::copyBufferRegions(
+    const pandora::core::gpu::Buffer& src,
+    const pandora::core::gpu::Buffer& dst,
+    const std::vector<pandora::core::BufferCopyRegion>& regions) {
+  commitBarriersInternal();
+  m_commands.emplace_back(
+      [&src, &dst, regions](pandora::core::TransferCommandBuffer& cmd) {
+        cmd.copyBufferRegions(src, dst, regions);
+      });
+  return *this;
+}
+
 TransferPlan& TransferPlan::copyBufferToImage(
     const pandora::core::gpu::Buffer& src,
     const pandora::core::gpu::Image& dst,
@@ -248,6 +269,117 @@ void TransferPlan::reset() {
   m_hasPendingBarriers = false;
 }
 
+UploadBatch::UploadBatch(const pandora::core::gpu::Context& context)
+    : m_contextOwner(context) {
+  if (!context.isInitialized()) {
+    return;
+  }
+
+  const auto& limits = context.getPtrDevice()->getLimits();
+  m_copyAlignment = std::max(
+      static_cast<size_t>(limits.optimalBufferCopyOffsetAlignment), size_t{4u});
+}
+
+pandora::core::VoidResult UploadBatch::add(
+    const pandora::core::gpu::Buffer& dst,
+    std::span<const std::byte> data,
+    size_t dst_offset) {
+  if (data.empty()) {
+    return pandora::core::ok();
+  }
+  if (dst_offset + data.size_bytes() > dst.getSize()) {
+    return pandora::core::Error::validation(
+               "Upload range exceeds destination buffer size")
+        .withContext("UploadBatch::add");
+  }
+
+  const bool is_direct = canWriteDirectly(m_contextOwner.get(), dst);
+  if (!is_direct) {
+    m_stagingSize = (m_stagingSize + m_copyAlignment - 1u) / m_copyAlignment
+                        * m_copyAlignment
+                    + data.size_bytes();
+  }
+  m_uploads.push_back(PendingUpload{dst, data, dst_offset, is_direct});
+  return pandora::core::ok();
+}
+
+pandora::core::VoidResult UploadBatch::record(TransferPlan& plan) {
+  const auto& context = m_contextOwner.get();
+  if (!context.isInitialized()) {
+    return pandora::core::Error::runtime("Context not initialized")
+        .withContext("UploadBatch::record");
+  }
+  if (m_uploads.empty()) {
+    return pandora::core::ok();
+  }
+  if (m_ptrStaging) {
+    return pandora::core::Error::validation(
+               "Batch already recorded; reset() it after its submission "
+               "completed")
+        .withContext("UploadBatch::record");
+  }
+
+  for (const auto& upload : m_uploads) {
+    if (upload.is_direct) {
+      writeToMappedBuffer(upload.dst.get(), upload.data, upload.dst_offset);
+    }
+  }
+  if (m_stagingSize == 0u) {
+    m_uploads.clear();
+    return pandora::core::ok();
+  }
+
+  m_ptrStaging =
+      pandora::core::createUniqueStagingBufferToGPU(context, m_stagingSize);
+  const auto staging_span = m_ptrStaging->getMappedSpan();
+
+  // One region list per destination, in first-seen order
+  std::vector<std::pair<const pandora::core::gpu::Buffer*,
+                        std::vector<pandora::core::BufferCopyRegion>>>
+      copies;
+  std::unordered_map<const pandora::core::gpu::Buffer*, size_t> copy_indices;
+
+  size_t src_offset = 0u;
+  for (const auto& upload : m_uploads) {
+    if (upload.is_direct) {
+      continue;
+    }
+    src_offset =
+        (src_offset + m_copyAlignment - 1u) / m_copyAlignment * m_copyAlignment;
+    std::memcpy(staging_span.data() + src_offset,
+                upload.data.data(),
+                upload.data.size_bytes());
+
+    const auto* dst = &upload.dst.get();
+    auto [it, inserted] = copy_indices.try_emplace(dst, copies.size());
+    if (inserted) {
+      copies.emplace_back(dst,
+                          std::vector<pandora::core::BufferCopyRegion>{});
+    }
+    copies.at(it->second)
+        .second.push_back(pandora::core::BufferCopyRegion{}
+                              .setSrcOffset(src_offset)
+                              .setDstOffset(upload.dst_offset)
+                              .setSize(upload.data.size_bytes()));
+
+    src_offset += upload.data.size_bytes();
+  }
+  m_ptrStaging->flushRange(0u, src_offset);
+
+  for (const auto& [dst, regions] : copies) {
+    plan.copyBufferRegions(*m_ptrStaging, *dst, regions);
+  }
+
+  m_uploads.clear();
+  return pandora::core::ok();
+}
+
+void UploadBatch::reset() {
+  m_uploads.clear();
+  m_ptrStaging.reset();
+  m_stagingSize = 0u;
+}
+
 pandora::core::CommandDriver& ResourceTransfer::ensureDriver() {
   if (!m_transferDriver) {
     m_transferDriver = std::make_unique<pandora::core::CommandDriver>(
@@ -256,6 +388,178 @@ pandora::core::CommandDriver& ResourceTransfer::ensureDriver() {
   return *m_transferDriver;
 }
 
+ResourceTransfer::~ResourceTransfer() {
+  if (m_ptrTimeline && !m_pendingTransfers.empty()) {
+    m_ptrTimeline->wait(m_contextOwner.get(), m_lastSubmittedValue);
+    retireUpTo(m_lastSubmittedValue);
+  }
+}
+
+pandora::core::gpu::TimelineSemaphore& ResourceTransfer::ensureTimeline() {
+  if (!m_ptrTimeline) {
+    m_ptrTimeline = std::make_unique<pandora::core::gpu::TimelineSemaphore>(
+        m_contextOwner.get());
+  }
+  return *m_ptrTimeline;
+}
+
+pandora::core::Result<TransferTicket> ResourceTransfer::submitAsync(
+    pandora::core::gpu::Buffer&& staging,
+    std::span<std::byte> readback_out,
+    const std::function<void(pandora::core::TransferCommandBuffer&,
+                             const pandora::core::gpu::Buffer&)>& record_fn) {
+  const auto& context = m_contextOwner.get();
+  collectCompleted();
+
+  auto& timeline = ensureTimeline();
+
+  // Every in-flight submission needs its own command buffer
+  std::unique_ptr<pandora::core::CommandDriver> driver;
+  if (!m_idleDrivers.empty()) {
+    driver = std::move(m_idleDrivers.back());
+    m_idleDrivers.pop_back();
+  } else {
+    driver = std::make_unique<pandora::core::CommandDriver>(context,
+                                                            m_queueFamilyType);
+  }
+
+  driver->resetAllCommandPools(context);
+  auto cmd = driver->getTransfer();
+  cmd.begin();
+  record_fn(cmd, staging);
+  cmd.end();
+
+  const auto value = m_lastSubmittedValue + 1u;
+  driver->submit(pandora::core::SubmitSemaphoreGroup{}.setSignalSemaphores(
+      {pandora::core::SubmitSemaphore{}
+           .setSemaphore(timeline)
+           .setValue(value)
+           .setStageMask(pandora::core::PipelineStage::AllCommands)}));
+  m_lastSubmittedValue = value;
+
+  m_pendingTransfers.push_back(PendingTransfer{
+      value, std::move(staging), std::move(driver), readback_out});
+
+  return TransferTicket{timeline, value};
+}
+
+void ResourceTransfer::retireUpTo(uint64_t completed_value) {
+  while (!m_pendingTransfers.empty()
+         && m_pendingTransfers.front().value <= completed_value) {
+    auto& pending = m_pendingTransfers.front();
+    if (!pending.readback_out.empty()) {
+      readFromStagingBuffer(pending.staging, pending.readback_out);
+    }
+    m_idleDrivers.push_back(std::move(pending.driver));
+    m_pendingTransfers.pop_front();
+  }
+}
+
+void ResourceTransfer::collectCompleted() {
+  if (!m_ptrTimeline || m_pendingTransfers.empty()) {
+    return;
+  }
+  retireUpTo(m_ptrTimeline->getCounterValue(m_contextOwner.get()));
+}
+
+bool ResourceTransfer::isComplete(const TransferTicket& ticket) const {
+  return ticket.semaphore.get().getCounterValue(m_contextOwner.get())
+         >= ticket.value;
+}
+
+pandora::core::VoidResult ResourceTransfer::wait(const TransferTicket& ticket,
+                                                 uint64_t timeout) {
+  if (!ticket.semaphore.get().wait(
+          m_contextOwner.get(), ticket.value, timeout)) {
+    return pandora::core::Error::gpu("Timed out waiting for transfer ticket")
+        .withContext("ResourceTransfer::wait");
+  }
+
+  collectCompleted();
+  return pandora::core::ok();
+}
+
+pandora::core::Result<TransferTicket> ResourceTransfer::uploadBufferAsync(
+    pandora::core::gpu::Buffer& dst, std::span<const std::byte> data) {
+  const auto& context = m_contextOwner.get();
+  if (!context.isInitialized()) {
+    return pandora::core::Error::runtime("Context not initialized")
+        .withContext("ResourceTransfer::uploadBufferAsync");
+  }
+  if (data.size_bytes() > dst.getSize()) {
+    return pandora::core::Error::validation(
+               "Upload size exceeds destination buffer size")
+        .withContext("ResourceTransfer::uploadBufferAsync");
+  }
+
+  // Value 0 is reached from the start, so the ticket is already complete
+  if (canWriteDirectly(context, dst)) {
+    writeToMappedBuffer(dst, data);
+    return TransferTicket{ensureTimeline(), 0u};
+  }
+
+  auto staging =
+      pandora::core::createStagingBufferToGPU(context, data.size_bytes());
+  writeToMappedBuffer(staging, data);
+
+  const auto record_fn = [&](pandora::core::TransferCommandBuffer& cmd,
+                             const pandora::core::gpu::Buffer& staging_buffer) {
+    cmd.copyBuffer(staging_buffer, dst);
+  };
+  return submitAsync(std::move(staging), {}, record_fn);
+}
+
+pandora::core::Result<TransferTicket> ResourceTransfer::uploadImageAsync(
+    pandora::core::gpu::Image& dst,
+    const pandora::core::ImageViewInfo& view_info,
+    std::span<const std::byte> data) {
+  const auto& context = m_contextOwner.get();
+  if (!context.isInitialized()) {
+    return pandora::core::Error::runtime("Context not initialized")
+        .withContext("ResourceTransfer::uploadImageAsync");
+  }
+
+  auto staging =
+      pandora::core::createStagingBufferToGPU(context, data.size_bytes());
+  writeToMappedBuffer(staging, data);
+
+  const auto record_fn = [&](pandora::core::TransferCommandBuffer& cmd,
+                             const pandora::core::gpu::Buffer& staging_buffer) {
+    cmd.copyBufferToImage(staging_buffer,
+                          dst,
+                          pandora::core::ImageLayout::TransferDstOptimal,
+                          view_info);
+  };
+  return submitAsync(std::move(staging), {}, record_fn);
+}
+
+pandora::core::Result<TransferTicket> ResourceTransfer::readbackBufferAsync(
+    pandora::core::gpu::Buffer& src, std::span<std::byte> out) {
+  const auto& context = m_contextOwner.get();
+  if (!context.isInitialized()) {
+    return pandora::core::Error::runtime("Context not initialized")
+        .withContext("ResourceTransfer::readbackBufferAsync");
+  }
+  if (out.size_bytes() > src.getSize()) {
+    return pandora::core::Error::validation(
+               "Readback size exceeds source buffer size")
+        .withContext("ResourceTransfer::readbackBufferAsync");
+  }
+
+  auto staging =
+      pandora::core::createStagingBufferFromGPU(context, out.size_bytes());
+
+  const auto record_fn = [&](pandora::core::TransferCommandBuffer& cmd,
+                             const pandora::core::gpu::Buffer& staging_buffer) {
+    // copyBuffer() would copy all of src, overrunning a smaller staging buffer
+    cmd.copyBufferRegions(
+        src,
+        staging_buffer,
+        {pandora::core::BufferCopyRegion{}.setSize(out.size_bytes())});
+  };
+  return submitAsync(std::move(staging), out, record_fn);
+}
+
 pandora::core::VoidResult ResourceTransfer::uploadBuffer(
     pandora::core::gpu::Buffer& dst, std::span<const std::byte> data) {
   const auto& context = m_contextOwner.get();
@@ -269,9 +573,14 @@ pandora::core::VoidResult ResourceTransfer::uploadBuffer(
         .withContext("ResourceTransfer::uploadBuffer");
   }
 
+  if (canWriteDirectly(context, dst)) {
+    writeToMappedBuffer(dst, data);
+    return pandora::core::ok();
+  }
+
   auto staging =
       pandora::core::createStagingBufferToGPU(context, data.size_bytes());
-  writeToStagingBuffer(staging, context, data);
+  writeToMappedBuffer(staging, data);
 
   auto& driver = ensureDriver();
   submitTransfer(
@@ -293,7 +602,7 @@ pandora::core::VoidResult ResourceTransfer::uploadImage(
   }
   auto staging =
       pandora::core::createStagingBufferToGPU(context, data.size_bytes());
-  writeToStagingBuffer(staging, context, data);
+  writeToMappedBuffer(staging, data);
 
   auto& driver = ensureDriver();
   submitTransfer(
@@ -326,10 +635,13 @@ pandora::core::VoidResult ResourceTransfer::readbackBuffer(
   auto& driver = ensureDriver();
   submitTransfer(
       driver, context, [&](pandora::core::TransferCommandBuffer& cmd) {
-        cmd.copyBuffer(src, staging);
+        cmd.copyBufferRegions(
+            src,
+            staging,
+            {pandora::core::BufferCopyRegion{}.setSize(out.size_bytes())});
       });
 
-  readFromStagingBuffer(staging, context, out);
+  readFromStagingBuffer(staging, out);
 
   return pandora::core::ok();
 }
@@ -1,18 +1,298 @@
 #include "pandora/highlevel/shader_library.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <ranges>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "pandora/core/gpu.hpp"
+#include "pandora/highlevel/pipeline_cache.hpp"
+
+#if defined(__linux__)
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int32_t POLL_INTERVAL_MS = 100;
+
+/// @brief Key of a watched shader, stable across spellings of its path
+std::string make_watch_key(const std::filesystem::path& path) {
+  std::error_code error_code;
+  auto absolute_path = std::filesystem::absolute(path, error_code);
+  if (error_code) {
+    absolute_path = path;
+  }
+  return absolute_path.lexically_normal().string();
+}
+
+/// @brief Modification time of a file, or nothing if it cannot be read
+std::optional<std::filesystem::file_time_type> get_write_time(
+    const std::string& path) {
+  std::error_code error_code;
+  const auto write_time = std::filesystem::last_write_time(path, error_code);
+  if (error_code) {
+    return std::nullopt;
+  }
+  return write_time;
+}
+
+}  // namespace
 
 namespace pandora::highlevel {
 
+struct ShaderLibrary::WatchState {
+  struct Entry {
+    std::string source_path;  ///< Path as passed to loadWatched()
+    std::shared_ptr<const pandora::core::gpu::ShaderModule> ptr_module;
+    /// Modification time of the loaded source, for the polling backend
+    std::optional<std::filesystem::file_time_type> write_time;
+    /// Changed time seen by the last poll; reloaded once it is stable
+    std::optional<std::filesystem::file_time_type> pending_write_time;
+  };
+
+  std::mutex mutex;
+  pandora::core::io::shader::CompileOptions compile_options;
+  std::unordered_map<std::string, Entry> entries;
+  std::unordered_map<std::string,
+                     std::shared_ptr<const pandora::core::gpu::ShaderModule>>
+      pending_modules;
+  std::vector<pandora::core::Error> reload_errors;
+
+  int32_t inotify_fd = -1;
+  std::unordered_map<int32_t, std::filesystem::path> watched_directories;
+  std::jthread watch_thread;
+
+  /// @brief Watch the directory of a shader file
+  /// @details Directories are watched rather than files, so editors that save
+  /// by renaming a temporary file over the shader are still noticed.
+  /// @note Caller holds mutex
+  void addDirectoryWatch(const std::string& key) {
+#if defined(__linux__)
+    const auto directory = std::filesystem::path(key).parent_path();
+    if (std::ranges::contains(watched_directories | std::views::values,
+                              directory)) {
+      return;
+    }
+
+    const auto watch_descriptor = inotify_add_watch(
+        inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_descriptor >= 0) {
+      watched_directories.emplace(watch_descriptor, directory);
+    }
+#else
+    static_cast<void>(key);
+#endif
+  }
+
+  /// @brief Recompile one shader and queue its module for applyReloads()
+  /// @details Runs on the watch thread, so every failure is queued as an
+  /// error instead of escaping and terminating the process.
+  void reload(const pandora::core::gpu::Context& context,
+              const std::string& key) {
+    std::string source_path;
+    pandora::core::io::shader::CompileOptions options;
+    {
+      std::lock_guard lock(mutex);
+      const auto entry = entries.find(key);
+      if (entry == entries.end()) {
+        return;
+      }
+      source_path = entry->second.source_path;
+      options = compile_options;
+    }
+
+    try {
+      auto spirv_result =
+          pandora::core::io::shader::read(source_path, options);
+      if (!spirv_result.isOk()) {
+        std::lock_guard lock(mutex);
+        reload_errors.push_back(
+            spirv_result.error().withContext("ShaderLibrary::reload"));
+        return;
+      }
+
+      auto ptr_module =
+          std::make_shared<const pandora::core::gpu::ShaderModule>(
+              context, spirv_result.value());
+
+      std::lock_guard lock(mutex);
+      pending_modules.insert_or_assign(key, std::move(ptr_module));
+    } catch (const vk::SystemError& e) {
+      std::lock_guard lock(mutex);
+      reload_errors.push_back(pandora::core::Error::gpu(e.what()).withContext(
+          "ShaderLibrary::reload"));
+    } catch (const std::exception& e) {
+      std::lock_guard lock(mutex);
+      reload_errors.push_back(pandora::core::Error::runtime(e.what())
+                                  .withContext("ShaderLibrary::reload"));
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      reload_errors.push_back(
+          pandora::core::Error::runtime("Unknown exception during reload")
+              .withContext("ShaderLibrary::reload"));
+    }
+  }
+
+#if defined(__linux__)
+  void watchFiles(std::stop_token stop_token,
+                  const pandora::core::gpu::Context& context) {
+    alignas(inotify_event) char buffer[4096];
+
+    while (!stop_token.stop_requested()) {
+      pollfd poll_fd{inotify_fd, POLLIN, 0};
+      if (poll(&poll_fd, 1, POLL_INTERVAL_MS) <= 0) {
+        continue;
+      }
+
+      const auto length = ::read(inotify_fd, buffer, sizeof(buffer));
+      if (length <= 0) {
+        continue;
+      }
+
+      // An editor save can raise several events for one file
+      std::unordered_set<std::string> changed_keys;
+      {
+        std::lock_guard lock(mutex);
+        for (const char* ptr = buffer; ptr < buffer + length;) {
+          const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+          ptr += sizeof(inotify_event) + event->len;
+
+          const auto directory = watched_directories.find(event->wd);
+          if (event->len == 0u || directory == watched_directories.end()) {
+            continue;
+          }
+
+          auto key = (directory->second / event->name).string();
+          if (entries.contains(key)) {
+            changed_keys.insert(std::move(key));
+          }
+        }
+      }
+
+      for (const auto& key : changed_keys) {
+        reload(context, key);
+      }
+    }
+  }
+#else
+  /// @brief Poll modification times of watched shaders
+  /// @details Portable backend for platforms without inotify, Windows
+  /// included. A changed time is only acted on once two polls agree, so a
+  /// file caught in the middle of being written is not compiled.
+  void pollFiles(std::stop_token stop_token,
+                 const pandora::core::gpu::Context& context) {
+    std::mutex wait_mutex;
+    std::condition_variable_any condition;
+
+    while (!stop_token.stop_requested()) {
+      {
+        std::unique_lock wait_lock(wait_mutex);
+        condition.wait_for(wait_lock,
+                           stop_token,
+                           std::chrono::milliseconds(POLL_INTERVAL_MS),
+                           []() { return false; });
+      }
+      if (stop_token.stop_requested()) {
+        return;
+      }
+
+      std::vector<std::string> keys;
+      {
+        std::lock_guard lock(mutex);
+        keys.reserve(entries.size());
+        for (const auto& key : entries | std::views::keys) {
+          keys.push_back(key);
+        }
+      }
+
+      // Stat without the lock; slow or network file systems would otherwise
+      // stall loadWatched() and applyReloads() on the render thread
+      std::vector<std::optional<std::filesystem::file_time_type>> write_times;
+      write_times.reserve(keys.size());
+      for (const auto& key : keys) {
+        write_times.push_back(get_write_time(key));
+      }
+
+      std::vector<std::string> changed_keys;
+      {
+        std::lock_guard lock(mutex);
+        for (size_t idx = 0u; idx < keys.size(); idx += 1u) {
+          // Skip keys that stopped being watched while unlocked
+          const auto found = entries.find(keys.at(idx));
+          if (found == entries.end()) {
+            continue;
+          }
+
+          auto& entry = found->second;
+          const auto& write_time = write_times.at(idx);
+          if (!write_time.has_value() || write_time == entry.write_time) {
+            entry.pending_write_time.reset();
+            continue;
+          }
+          if (write_time != entry.pending_write_time) {
+            entry.pending_write_time = write_time;
+            continue;
+          }
+          entry.write_time = write_time;
+          entry.pending_write_time.reset();
+          changed_keys.push_back(keys.at(idx));
+        }
+      }
+
+      for (const auto& key : changed_keys) {
+        reload(context, key);
+      }
+    }
+  }
+#endif
+};
+
+ShaderLibrary::ShaderLibrary(
+    const pandora::core::gpu::Context& context,
+    const pandora::core::io::shader::CompileOptions& compile_options)
+    : m_contextOwner(context),
+      m_ptrWatchState(std::make_unique<WatchState>()) {
+  m_ptrWatchState->compile_options = compile_options;
+}
+
+ShaderLibrary::~ShaderLibrary() {
+  stopWatching();
+}
+
+void ShaderLibrary::setCompileOptions(
+    const pandora::core::io::shader::CompileOptions& compile_options) {
+  std::lock_guard lock(m_ptrWatchState->mutex);
+  m_ptrWatchState->compile_options = compile_options;
+}
+
+pandora::core::io::shader::CompileOptions ShaderLibrary::getCompileOptions()
+    const {
+  std::lock_guard lock(m_ptrWatchState->mutex);
+  return m_ptrWatchState->compile_options;
+}
+
 pandora::core::Result<pandora::core::gpu::ShaderModule> ShaderLibrary::load(
     std::string_view path) const {
   if (!m_contextOwner.get().isInitialized()) {
     return pandora::core::Error::runtime("Context not initialized")
         .withContext("ShaderLibrary::load");
   }
-  const auto spirv_result = pandora::core::io::shader::read(std::string(path));
+  const auto spirv_result = pandora::core::io::shader::read(
+      std::string(path), getCompileOptions());
   if (!spirv_result.isOk()) {
     return spirv_result.error().withContext("ShaderLibrary::load");
   }
@@ -21,4 +301,143 @@ pandora::core::Result<pandora::core::gpu::ShaderModule> ShaderLibrary::load(
                                           spirv_result.value());
 }
 
+pandora::core::Result<std::shared_ptr<const pandora::core::gpu::ShaderModule>>
+ShaderLibrary::loadWatched(std::string_view path) {
+  auto& state = *m_ptrWatchState;
+  const auto key = make_watch_key(path);
+  {
+    std::lock_guard lock(state.mutex);
+    if (const auto it = state.entries.find(key); it != state.entries.end()) {
+      return it->second.ptr_module;
+    }
+  }
+
+  // Taken before compiling, so an edit made meanwhile is still picked up
+  const auto write_time = get_write_time(key);
+  auto module_result = load(path);
+  if (!module_result.isOk()) {
+    return module_result.error().withContext("ShaderLibrary::loadWatched");
+  }
+
+  std::lock_guard lock(state.mutex);
+  const auto [it, is_inserted] = state.entries.try_emplace(
+      key,
+      WatchState::Entry{
+          std::string(path),
+          std::make_shared<const pandora::core::gpu::ShaderModule>(
+              module_result.takeValue()),
+          write_time,
+          std::nullopt});
+  if (is_inserted && state.inotify_fd >= 0) {
+    state.addDirectoryWatch(key);
+  }
+  return it->second.ptr_module;
+}
+
+std::shared_ptr<const pandora::core::gpu::ShaderModule>
+ShaderLibrary::getWatched(std::string_view path) const {
+  auto& state = *m_ptrWatchState;
+  std::lock_guard lock(state.mutex);
+  const auto it = state.entries.find(make_watch_key(path));
+  return it != state.entries.end() ? it->second.ptr_module : nullptr;
+}
+
+pandora::core::VoidResult ShaderLibrary::startWatching() {
+  auto& state = *m_ptrWatchState;
+  if (isWatching()) {
+    return pandora::core::ok();
+  }
+
+#if defined(__linux__)
+  {
+    std::lock_guard lock(state.mutex);
+    state.inotify_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (state.inotify_fd < 0) {
+      return pandora::core::Error::io("Failed to initialize inotify")
+          .withContext("ShaderLibrary::startWatching");
+    }
+    for (const auto& key : state.entries | std::views::keys) {
+      state.addDirectoryWatch(key);
+    }
+  }
+
+  state.watch_thread = std::jthread(
+      [&state, &context = m_contextOwner.get()](std::stop_token stop_token) {
+        state.watchFiles(stop_token, context);
+      });
+#else
+  state.watch_thread = std::jthread(
+      [&state, &context = m_contextOwner.get()](std::stop_token stop_token) {
+        state.pollFiles(stop_token, context);
+      });
+#endif
+  return pandora::core::ok();
+}
+
+void ShaderLibrary::stopWatching() {
+  auto& state = *m_ptrWatchState;
+  if (!state.watch_thread.joinable()) {
+    return;
+  }
+
+  state.watch_thread.request_stop();
+  state.watch_thread.join();
+
+#if defined(__linux__)
+  std::lock_guard lock(state.mutex);
+  close(state.inotify_fd);
+  state.inotify_fd = -1;
+  state.watched_directories.clear();
+#endif
+}
+
+bool ShaderLibrary::isWatching() const {
+  return m_ptrWatchState->watch_thread.joinable();
+}
+
+std::vector<std::string> ShaderLibrary::applyReloads(
+    const pandora::core::gpu::Fence& fence, PipelineCache* ptr_pipeline_cache) {
+  auto& state = *m_ptrWatchState;
+  std::unordered_map<std::string,
+                     std::shared_ptr<const pandora::core::gpu::ShaderModule>>
+      pending_modules;
+  {
+    std::lock_guard lock(state.mutex);
+    pending_modules.swap(state.pending_modules);
+  }
+
+  auto& deletion_queue = *m_contextOwner.get().getPtrDeletionQueue();
+  std::vector<std::string> reloaded_paths;
+  for (auto& [key, ptr_module] : pending_modules) {
+    std::shared_ptr<const pandora::core::gpu::ShaderModule> ptr_old_module;
+    {
+      std::lock_guard lock(state.mutex);
+      auto& entry = state.entries.at(key);
+
+      // Saving without edits yields the same code; keep the old pipelines
+      if (entry.ptr_module->getContentHash() == ptr_module->getContentHash()) {
+        continue;
+      }
+      ptr_old_module = std::exchange(entry.ptr_module, std::move(ptr_module));
+      reloaded_paths.push_back(entry.source_path);
+    }
+
+    if (ptr_pipeline_cache != nullptr) {
+      for (auto& ptr_pipeline :
+           ptr_pipeline_cache->evictShader(ptr_old_module->getContentHash())) {
+        deletion_queue.push(std::move(ptr_pipeline), fence);
+      }
+    }
+    deletion_queue.push(std::move(ptr_old_module), fence);
+  }
+
+  return reloaded_paths;
+}
+
+std::vector<pandora::core::Error> ShaderLibrary::takeReloadErrors() {
+  auto& state = *m_ptrWatchState;
+  std::lock_guard lock(state.mutex);
+  return std::exchange(state.reload_errors, {});
+}
+
 }  // namespace pandora::highlevel
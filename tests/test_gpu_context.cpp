@@ -1,4 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
 
 #include "pandolabo.hpp"
 #include "util/test_env.hpp"
@@ -18,3 +20,158 @@ TEST_CASE("Headless GPU Context initializes", "[gpu][context]") {
   // No swapchain expected in headless mode
   REQUIRE(ctx.getPtrSwapchain() == nullptr);
 }
+
+TEST_CASE("Deletion queue frees resources once the timeline passes",
+          "[gpu][context]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  REQUIRE(ctx.getPtrDeletionQueue() != nullptr);
+
+  gpu::TimelineSemaphore timeline{ctx};
+  auto& deletion_queue = *ctx.getPtrDeletionQueue();
+  deletion_queue.push(createStorageBuffer(ctx, TransferType::TransferDst, 64u),
+                      timeline,
+                      1u);
+  deletion_queue.push(createStagingBufferToGPU(ctx, 64u), timeline, 2u);
+
+  REQUIRE(deletion_queue.collect() == 0u);
+  REQUIRE(deletion_queue.getPendingCount() == 2u);
+
+  TimelineSemaphoreDriver{}.setSemaphores({timeline}).setValues({1u}).signal(
+      ctx);
+  REQUIRE(deletion_queue.collect() == 1u);
+  REQUIRE(deletion_queue.getPendingCount() == 1u);
+
+  // Remaining entries are destroyed with the context
+}
+
+TEST_CASE("Memory stats report heaps and live resources", "[gpu][context]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const auto before = ctx.memoryStats();
+  REQUIRE_FALSE(before.heaps.empty());
+
+  {
+    auto buffer = createStorageBuffer(ctx, TransferType::TransferDst, 256u);
+    const auto during = ctx.memoryStats();
+    REQUIRE(during.live_resources.buffers
+            == before.live_resources.buffers + 1u);
+    REQUIRE(during.total_allocation_count
+            == before.total_allocation_count + 1u);
+
+    for (const auto& heap : during.heaps) {
+      REQUIRE(heap.used_bytes <= heap.allocated_bytes);
+      REQUIRE(heap.budget_bytes.has_value() == during.has_memory_budget);
+    }
+
+    ctx.getPtrAllocator()->markFrame();
+    REQUIRE(ctx.memoryStats().frame_allocation_count
+            == during.total_allocation_count);
+  }
+
+  const auto after = ctx.memoryStats();
+  REQUIRE(after.live_resources.buffers == before.live_resources.buffers);
+  REQUIRE(after.total_free_count == before.total_free_count + 1u);
+  REQUIRE(after.toJson().find("\"heaps\"") != std::string::npos);
+}
+
+TEST_CASE("Identical samplers and image views share handles",
+          "[gpu][context]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const auto sampler_info = SamplerInfo{}
+                                .setFilters(SamplerFilter::Linear,
+                                            SamplerFilter::Linear)
+                                .setMipmapMode(SamplerMipmapMode::Linear)
+                                .setLodRange(0.0f, 4.0f);
+  {
+    const gpu::Sampler first{ctx, sampler_info};
+    const gpu::Sampler second{ctx, sampler_info};
+    REQUIRE(first.getSampler() == second.getSampler());
+    REQUIRE(ctx.getPtrSamplerCache()->getLiveCount() == 1u);
+
+    const gpu::Sampler nearest{
+        ctx,
+        SamplerInfo{sampler_info}.setFilters(SamplerFilter::Nearest,
+                                             SamplerFilter::Nearest)};
+    REQUIRE(nearest.getSampler() != first.getSampler());
+    REQUIRE(ctx.getPtrSamplerCache()->getLiveCount() == 2u);
+  }
+  REQUIRE(ctx.getPtrSamplerCache()->getLiveCount() == 0u);
+
+  const gpu::Image image{ctx,
+                         MemoryUsage::GpuOnly,
+                         TransferType::TransferDst,
+                         {ImageUsage::Sampled},
+                         ImageSubInfo{}
+                             .setSize(4u, 4u)
+                             .setMipLevels(2u)
+                             .setSamples(ImageSampleCount::v1)
+                             .setFormat(DataFormat::R8G8B8A8Unorm)
+                             .setDimension(ImageDimension::v2D)};
+  const auto view_info = ImageViewInfo{}
+                             .setMipRange(0u, 2u)
+                             .setArrayRange(0u, 1u)
+                             .setAspect(ImageAspect::Color);
+  const gpu::ImageView first_view{ctx, image, view_info};
+  const gpu::ImageView second_view{ctx, image, view_info};
+  const gpu::ImageView top_mip_view{
+      ctx, image, ImageViewInfo{view_info}.setMipRange(0u, 1u)};
+  REQUIRE(first_view.getImageView() == second_view.getImageView());
+  REQUIRE(top_mip_view.getImageView() != first_view.getImageView());
+  REQUIRE(ctx.getPtrImageViewCache()->getLiveCount() == 2u);
+
+  // Copies share the cached handle
+  const gpu::ImageView copied_view = first_view;
+  REQUIRE(copied_view.getImageView() == first_view.getImageView());
+
+  // Purging an image, as its destructor does, hides its views from lookups
+  ctx.getPtrImageViewCache()->purgeImage(image.getImage());
+  REQUIRE(ctx.getPtrImageViewCache()->getLiveCount() == 0u);
+  const gpu::ImageView fresh_view{ctx, image, view_info};
+  REQUIRE(fresh_view.getImageView() != first_view.getImageView());
+}
+
+TEST_CASE("Pipeline cache persists across contexts", "[gpu][context]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  const auto cache_path =
+      std::filesystem::temp_directory_path() / "pandolabo_pipeline_cache.bin";
+  std::filesystem::remove(cache_path);
+
+  {
+    std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+    gpu::Context ctx{no_surface, cache_path};
+    REQUIRE(ctx.isInitialized());
+    REQUIRE_FALSE(ctx.getPtrPipelineCacheStore()->isLoadedFromFile());
+    REQUIRE(ctx.getPtrPipelineCacheStore()->save().isOk());
+  }
+  REQUIRE(std::filesystem::exists(cache_path));
+
+  {
+    std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+    gpu::Context ctx{no_surface, cache_path};
+    REQUIRE(ctx.getPtrPipelineCacheStore()->isLoadedFromFile());
+  }
+
+  // A corrupt file is ignored instead of being handed to the driver
+  std::ofstream(cache_path, std::ios::binary | std::ios::trunc) << "garbage";
+  {
+    std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+    gpu::Context ctx{no_surface, cache_path};
+    REQUIRE(ctx.isInitialized());
+    REQUIRE_FALSE(ctx.getPtrPipelineCacheStore()->isLoadedFromFile());
+  }
+  std::filesystem::remove(cache_path);
+}
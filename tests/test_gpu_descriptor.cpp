@@ -0,0 +1,540 @@
+#include <array>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+#include "pandolabo.hpp"
+#include "util/compile_cache.hpp"
+#include "util/test_env.hpp"
+
+using namespace pandora::core;
+
+namespace {
+
+constexpr auto STORAGE_BUFFER_SHADER = R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] += 1u; }
+)";
+
+constexpr auto MULTI_SET_SHADER = R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Frame { uint frame_index; } frame;
+layout(set = 2, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] += frame.frame_index; }
+)";
+
+constexpr auto BINDLESS_SHADER = R"(#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 2) buffer Data { uint values[]; } buffers[];
+layout(push_constant) uniform Indices { uint buffer_index; };
+void main() { buffers[nonuniformEXT(buffer_index)].values[0] += 1u; }
+)";
+
+gpu::ShaderModule create_compute_module(const gpu::Context& ctx,
+                                        const std::string& file_name,
+                                        const char* source) {
+  const auto path = std::filesystem::temp_directory_path() / file_name;
+  std::ofstream(path) << source;
+
+  const auto spirv = io::shader::readText(path.string());
+  REQUIRE(spirv.isOk());
+  return gpu::ShaderModule{ctx, spirv.value()};
+}
+
+}  // namespace
+
+TEST_CASE("Descriptor allocator shares pools and grows on demand",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{ctx, description_unit};
+
+  SECTION("Persistent sets come from the context allocator") {
+    const auto pools_before =
+        ctx.memoryStats().live_resources.descriptor_pools;
+    std::vector<gpu::DescriptorSet> sets;
+    for (uint32_t i = 0u; i < 16u; i += 1u) {
+      sets.emplace_back(ctx, layout);
+    }
+    REQUIRE(ctx.getPtrDescriptorAllocator()->getPoolCount() == 1u);
+    REQUIRE(ctx.memoryStats().live_resources.descriptor_pools
+            == pools_before + 1u);
+  }
+
+  SECTION("Transient allocator grows and resets without new pools") {
+    gpu::DescriptorAllocator allocator{
+        ctx, gpu::DescriptorAllocatorMode::Transient, 2u};
+    for (uint32_t i = 0u; i < 5u; i += 1u) {
+      REQUIRE(allocator.allocate(layout).descriptor_set);
+    }
+    // 2 + 4 sets fit in the first two pools
+    const auto pool_count = allocator.getPoolCount();
+    REQUIRE(pool_count == 2u);
+
+    allocator.reset();
+    for (uint32_t i = 0u; i < 5u; i += 1u) {
+      REQUIRE(allocator.allocate(layout).descriptor_set);
+    }
+    REQUIRE(allocator.getPoolCount() == pool_count);
+  }
+}
+
+TEST_CASE("Identical layouts are shared through the layout cache",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+
+  const auto& layout_cache = ctx.getPtrLayoutCache();
+  const gpu::DescriptorSetLayout first_layout{ctx, description_unit};
+  const auto set_layout_count = layout_cache->getDescriptorSetLayoutCount();
+  const gpu::DescriptorSetLayout second_layout{ctx, description_unit};
+  REQUIRE(first_layout.getDescriptorSetLayout()
+          == second_layout.getDescriptorSetLayout());
+  REQUIRE(layout_cache->getDescriptorSetLayoutCount() == set_layout_count);
+
+  const Pipeline first_pipeline{
+      ctx, description_unit, first_layout, PipelineBind::Compute};
+  const auto pipeline_layout_count = layout_cache->getPipelineLayoutCount();
+  const Pipeline second_pipeline{
+      ctx, description_unit, second_layout, PipelineBind::Compute};
+  REQUIRE(first_pipeline.getPipelineLayout()
+          == second_pipeline.getPipelineLayout());
+  REQUIRE(layout_cache->getPipelineLayoutCount() == pipeline_layout_count);
+
+  if (ctx.getPtrDevice()->hasPushDescriptor()) {
+    const gpu::DescriptorSetLayout push_layout{
+        ctx, description_unit, gpu::DescriptorSetLayoutType::PushDescriptor};
+    REQUIRE(push_layout.getDescriptorSetLayout()
+            != first_layout.getDescriptorSetLayout());
+  }
+}
+
+TEST_CASE("Descriptor update template rewrites sets from packed data",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{ctx, description_unit};
+  const gpu::DescriptorUpdateTemplate update_template{
+      ctx, description_unit, layout};
+
+  REQUIRE(update_template.getSlotCount() == 1u);
+  REQUIRE(update_template.getSlot(0u).isOk());
+  REQUIRE(update_template.getSlot(7u).isError());
+
+  auto ping = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  auto pong = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  pandora::highlevel::ResourceTransfer transfer{ctx};
+  const std::array<uint32_t, 16u> zeros{};
+  REQUIRE(transfer.uploadBuffer(ping, std::as_bytes(std::span(zeros))).isOk());
+  REQUIRE(transfer.uploadBuffer(pong, std::as_bytes(std::span(zeros))).isOk());
+
+  std::array<gpu::DescriptorData, 1u> descriptor_data{};
+  gpu::DescriptorSet descriptor_set{ctx, layout};
+  REQUIRE(descriptor_set
+              .updateDescriptorSet(
+                  ctx, update_template, std::span(descriptor_data).first(0u))
+              .isError());
+  for (const auto* buffer : {&ping, &pong, &ping}) {
+    descriptor_data.at(update_template.getSlot(0u).value()) =
+        gpu::DescriptorData::fromBuffer(*buffer);
+    const auto update_result = descriptor_set.updateDescriptorSet(
+        ctx, update_template, descriptor_data);
+    REQUIRE(update_result.isOk());
+  }
+
+  // The set written last through the template points at ping
+  Pipeline pipeline{ctx, description_unit, layout, PipelineBind::Compute};
+  pipeline.constructComputePipeline(ctx, shader_modules.at("compute"));
+  CommandDriver driver{ctx, QueueFamilyType::Compute};
+  auto command_buffer = driver.getCompute();
+  command_buffer.begin();
+  command_buffer.bindPipeline(pipeline);
+  command_buffer.bindDescriptorSet(pipeline, descriptor_set);
+  command_buffer.compute(ComputeWorkGroupSize{1u, 1u, 1u});
+  command_buffer.end();
+  driver.submit(SubmitSemaphoreGroup{});
+  driver.queueWaitIdle();
+
+  std::array<uint32_t, 16u> ping_values{};
+  std::array<uint32_t, 16u> pong_values{};
+  REQUIRE(transfer
+              .readbackBuffer(ping,
+                              std::as_writable_bytes(std::span(ping_values)))
+              .isOk());
+  REQUIRE(transfer
+              .readbackBuffer(pong,
+                              std::as_writable_bytes(std::span(pong_values)))
+              .isOk());
+  REQUIRE(ping_values.at(0u) == 1u);
+  REQUIRE(pong_values.at(0u) == 0u);
+}
+
+TEST_CASE("Descriptor sets are grouped by their reflected set index",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_multi_set_test.comp", MULTI_SET_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  REQUIRE(description_unit.getSetIndices() == std::vector<uint32_t>{0u, 2u});
+
+  const gpu::DescriptorSetLayout frame_layout{ctx, description_unit, 0u};
+  const gpu::DescriptorSetLayout object_layout{ctx, description_unit, 2u};
+  REQUIRE(object_layout.getSetIndex() == 2u);
+  REQUIRE(object_layout.getDescriptorPoolSizes().size() == 1u);
+
+  // Set 1 is unused by the shader and gets an empty layout
+  Pipeline pipeline{
+      ctx, description_unit, {object_layout, frame_layout},
+      PipelineBind::Compute};
+  pipeline.constructComputePipeline(ctx, shader_modules.at("compute"));
+  REQUIRE(pipeline.getPipeline());
+
+  const gpu::DescriptorSet frame_set{ctx, frame_layout};
+  const gpu::DescriptorSet object_set{ctx, object_layout};
+  REQUIRE(frame_set.getSetIndex() == 0u);
+  REQUIRE(object_set.getSetIndex() == 2u);
+}
+
+TEST_CASE("Push descriptors bind per dispatch without a descriptor set",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  if (!ctx.getPtrDevice()->hasPushDescriptor()) {
+    SUCCEED("VK_KHR_push_descriptor is not supported on this device");
+    return;
+  }
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{
+      ctx, description_unit, gpu::DescriptorSetLayoutType::PushDescriptor};
+  REQUIRE(layout.getLayoutType()
+          == gpu::DescriptorSetLayoutType::PushDescriptor);
+
+  Pipeline pipeline{ctx, description_unit, layout, PipelineBind::Compute};
+  pipeline.constructComputePipeline(ctx, shader_modules.at("compute"));
+
+  const auto buffer = createStorageBuffer(ctx, TransferType::TransferDst, 64u);
+  const auto pools_before = ctx.memoryStats().live_resources.descriptor_pools;
+
+  CommandDriver driver{ctx, QueueFamilyType::Compute};
+  auto command_buffer = driver.getCompute();
+  command_buffer.begin();
+  command_buffer.bindPipeline(pipeline);
+  command_buffer.pushDescriptors(
+      pipeline,
+      {gpu::BufferDescription{
+          description_unit.getDescriptorInfoMap().begin()->second, buffer}},
+      {});
+  command_buffer.compute(ComputeWorkGroupSize{1u, 1u, 1u});
+  command_buffer.end();
+  driver.submit(SubmitSemaphoreGroup{});
+  driver.queueWaitIdle();
+
+  REQUIRE(ctx.memoryStats().live_resources.descriptor_pools == pools_before);
+}
+
+TEST_CASE("Bindless heap hands out stable, reusable indices",
+          "[gpu][descriptor]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  if (!ctx.getPtrDevice()->hasDescriptorIndexing()) {
+    SUCCEED("Descriptor indexing is not supported on this device");
+    return;
+  }
+
+  gpu::BindlessHeap heap{ctx, 4u, 4u, 2u};
+  REQUIRE(heap.getCapacity(gpu::BindlessResource::StorageBuffer) == 2u);
+
+  const auto buffer = createStorageBuffer(ctx, TransferType::TransferDst, 64u);
+  const auto first = heap.registerStorageBuffer(buffer);
+  const auto second = heap.registerStorageBuffer(buffer, 0u, 32u);
+  REQUIRE(first.isOk());
+  REQUIRE(second.isOk());
+  REQUIRE(first.value() != second.value());
+  REQUIRE(heap.registerStorageBuffer(buffer).isError());
+
+  heap.release(gpu::BindlessResource::StorageBuffer, first.value());
+  REQUIRE(heap.getRegisteredCount(gpu::BindlessResource::StorageBuffer) == 1u);
+  const auto reused = heap.registerStorageBuffer(buffer);
+  REQUIRE(reused.isOk());
+  REQUIRE(reused.value() == first.value());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_bindless_test.comp", BINDLESS_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  Pipeline pipeline{ctx, description_unit, heap, PipelineBind::Compute};
+  pipeline.constructComputePipeline(ctx, shader_modules.at("compute"));
+  REQUIRE(pipeline.getPipeline());
+}
+
+TEST_CASE("Pipeline cache deduplicates structurally equal pipelines",
+          "[gpu][pipeline]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  // Two modules built from the same source at different call sites
+  const auto first_module = create_compute_module(
+      ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER);
+  const auto second_module = create_compute_module(
+      ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER);
+  REQUIRE(first_module.getContentHash() == second_module.getContentHash());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{ctx, description_unit};
+
+  pandora::highlevel::PipelineCache pipeline_cache{ctx};
+  auto& first = pipeline_cache.getOrCreateCompute(
+      description_unit, {layout}, first_module);
+  auto& second = pipeline_cache.getOrCreateCompute(
+      description_unit, {layout}, second_module);
+  REQUIRE(&first == &second);
+  REQUIRE(pipeline_cache.size() == 1u);
+}
+
+TEST_CASE("Pipeline compiler builds a batch on worker threads",
+          "[gpu][pipeline]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{ctx, description_unit};
+  const auto& shader_module = shader_modules.at("compute");
+
+  constexpr size_t PIPELINE_COUNT = 12u;
+  std::vector<std::unique_ptr<pandora::core::Pipeline>> pipelines;
+  std::vector<pandora::highlevel::PipelineCompiler::ComputeTarget> targets;
+  for (size_t i = 0u; i < PIPELINE_COUNT; i += 1u) {
+    pipelines.push_back(std::make_unique<pandora::core::Pipeline>(
+        ctx, description_unit, layout, pandora::core::PipelineBind::Compute));
+    targets.push_back({*pipelines.back(), shader_module});
+  }
+
+  pandora::highlevel::PipelineCompiler compiler{ctx, 3u, 2u};
+  REQUIRE(compiler.getWorkerCount() == 3u);
+
+  std::atomic<bool> is_completed = false;
+  auto future = compiler.compileCompute(
+      std::move(targets),
+      [&is_completed](const pandora::core::VoidResult&) {
+        is_completed = true;
+      });
+  const auto result = future.get();
+  REQUIRE(result.isOk());
+  REQUIRE(is_completed);
+
+  for (const auto& pipeline : pipelines) {
+    REQUIRE(pipeline->getPipeline() != vk::Pipeline{});
+  }
+
+  REQUIRE(compiler.compileCompute({}).get().isOk());
+
+  // A throwing callback still makes the future ready
+  const auto throwing_result =
+      compiler
+          .compileCompute({},
+                          [](const pandora::core::VoidResult&) {
+                            throw std::runtime_error("callback failed");
+                          })
+          .get();
+  REQUIRE(throwing_result.isError());
+}
+
+TEST_CASE("Watched shaders are reloaded and stale pipelines evicted",
+          "[gpu][shader]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const ScopedCompileCache cache{"pandolabo_hot_reload_test"};
+
+  const auto shader_path =
+      std::filesystem::temp_directory_path() / "pandolabo_hot_reload.comp";
+  std::ofstream(shader_path) << STORAGE_BUFFER_SHADER;
+
+  pandora::highlevel::ShaderLibrary shader_library{ctx};
+  const auto watched = shader_library.loadWatched(shader_path.string());
+  REQUIRE(watched.isOk());
+  REQUIRE(shader_library.loadWatched(shader_path.string()).value()
+          == watched.value());
+  REQUIRE(shader_library.getWatched(shader_path.string()) == watched.value());
+
+  std::unordered_map<std::string, gpu::ShaderModule> shader_modules;
+  shader_modules.emplace(
+      "compute",
+      create_compute_module(
+          ctx, "pandolabo_descriptor_test.comp", STORAGE_BUFFER_SHADER));
+  const gpu::DescriptionUnit description_unit{shader_modules, {"compute"}};
+  const gpu::DescriptorSetLayout layout{ctx, description_unit};
+
+  pandora::highlevel::PipelineCache pipeline_cache{ctx};
+  static_cast<void>(pipeline_cache.getOrCreateCompute(
+      description_unit, {layout}, *watched.value()));
+  REQUIRE(pipeline_cache.size() == 1u);
+
+  // inotify on Linux, modification-time polling on other platforms
+  REQUIRE(shader_library.startWatching().isOk());
+  REQUIRE(shader_library.isWatching());
+
+  std::ofstream(shader_path) << R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] += 2u; }
+)";
+
+  std::vector<std::string> reloaded_paths;
+  for (uint32_t attempt = 0u; attempt < 100u && reloaded_paths.empty();
+       attempt += 1u) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reloaded_paths = shader_library.applyReloads(gpu::Fence{}, &pipeline_cache);
+  }
+  REQUIRE(shader_library.takeReloadErrors().empty());
+  REQUIRE(reloaded_paths.size() == 1u);
+  REQUIRE(shader_library.getWatched(shader_path.string())->getContentHash()
+          != watched.value()->getContentHash());
+  REQUIRE(pipeline_cache.size() == 0u);
+
+  shader_library.stopWatching();
+  REQUIRE_FALSE(shader_library.isWatching());
+}
+
+TEST_CASE("Shader reflection is reloaded from its sidecar", "[gpu][shader]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const ScopedCompileCache cache{"pandolabo_reflection_test"};
+
+  const auto reflected = create_compute_module(
+      ctx, "pandolabo_reflection_test.comp", BINDLESS_SHADER);
+
+  std::vector<std::filesystem::path> sidecars;
+  for (const auto& entry : cache.getEntries()) {
+    if (entry.extension() == ".refl") {
+      sidecars.push_back(entry);
+    }
+  }
+  REQUIRE(sidecars.size() == 1u);
+
+  const auto check_matches = [&reflected](const gpu::ShaderModule& loaded) {
+    REQUIRE(loaded.getEntryPointName() == reflected.getEntryPointName());
+    REQUIRE(loaded.getShaderStageFlag() == reflected.getShaderStageFlag());
+    REQUIRE(loaded.getContentHash() == reflected.getContentHash());
+
+    const auto& descriptor_infos = loaded.getDescriptorInfoMap();
+    REQUIRE(descriptor_infos.size()
+            == reflected.getDescriptorInfoMap().size());
+    for (const auto& [name, info] : reflected.getDescriptorInfoMap()) {
+      const auto& loaded_info = descriptor_infos.at(name);
+      REQUIRE(loaded_info.stage_flags == info.stage_flags);
+      REQUIRE(loaded_info.set == info.set);
+      REQUIRE(loaded_info.binding == info.binding);
+      REQUIRE(loaded_info.type == info.type);
+      REQUIRE(loaded_info.size == info.size);
+    }
+
+    const auto& push_constant_ranges = loaded.getPushConstantRangeMap();
+    REQUIRE(push_constant_ranges.size()
+            == reflected.getPushConstantRangeMap().size());
+    for (const auto& [name, range] : reflected.getPushConstantRangeMap()) {
+      const auto& loaded_range = push_constant_ranges.at(name);
+      REQUIRE(loaded_range.stage_flags == range.stage_flags);
+      REQUIRE(loaded_range.offset == range.offset);
+      REQUIRE(loaded_range.size == range.size);
+    }
+  };
+
+  // A valid sidecar is read, not rewritten: its backdated time survives
+  const auto backdated_time =
+      std::filesystem::last_write_time(sidecars.front())
+      - std::chrono::hours(1);
+  std::filesystem::last_write_time(sidecars.front(), backdated_time);
+  check_matches(create_compute_module(
+      ctx, "pandolabo_reflection_test.comp", BINDLESS_SHADER));
+  REQUIRE(std::filesystem::last_write_time(sidecars.front())
+          == backdated_time);
+
+  // A corrupt sidecar falls back to spirv-cross
+  std::filesystem::resize_file(sidecars.front(), 16u);
+  check_matches(create_compute_module(
+      ctx, "pandolabo_reflection_test.comp", BINDLESS_SHADER));
+  REQUIRE(std::filesystem::file_size(sidecars.front()) > 16u);
+}
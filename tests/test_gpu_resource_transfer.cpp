@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <span>
+
+#include "pandolabo.hpp"
+#include "util/test_env.hpp"
+
+using namespace pandora::core;
+
+TEST_CASE("Async upload and readback round-trip through tickets",
+          "[gpu][transfer]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  auto storage = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  pandora::highlevel::ResourceTransfer transfer{ctx};
+
+  std::array<std::byte, 64> source{};
+  for (size_t idx = 0u; idx < source.size(); idx += 1u) {
+    source.at(idx) = static_cast<std::byte>(idx);
+  }
+  std::array<std::byte, 64> result{};
+
+  auto upload = transfer.uploadBufferAsync(storage, std::span(source));
+  REQUIRE(upload.isOk());
+  REQUIRE(transfer.wait(upload.value()).isOk());
+  REQUIRE(transfer.isComplete(upload.value()));
+
+  auto readback = transfer.readbackBufferAsync(storage, std::span(result));
+  REQUIRE(readback.isOk());
+  REQUIRE(readback.value().value > upload.value().value);
+  REQUIRE(transfer.wait(readback.value()).isOk());
+
+  REQUIRE(transfer.getPendingCount() == 0u);
+  REQUIRE(result == source);
+}
+
+TEST_CASE("Readback into a smaller span copies only its prefix",
+          "[gpu][transfer]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  // Pin the staging path so the readback goes through a GPU copy
+  ctx.getPtrAllocator()->setDirectWriteEnabled(false);
+
+  auto storage = createStorageBuffer(ctx, TransferType::TransferSrcDst, 256u);
+  pandora::highlevel::ResourceTransfer transfer{ctx};
+
+  std::array<std::byte, 256> source{};
+  for (size_t idx = 0u; idx < source.size(); idx += 1u) {
+    source.at(idx) = static_cast<std::byte>(idx);
+  }
+  REQUIRE(transfer.uploadBuffer(storage, std::span(source)).isOk());
+
+  // The staging buffers hold 16 bytes; the source holds 256
+  std::array<std::byte, 16> sync_result{};
+  REQUIRE(transfer.readbackBuffer(storage, std::span(sync_result)).isOk());
+  REQUIRE(std::ranges::equal(sync_result,
+                             std::span(source).first(sync_result.size())));
+
+  std::array<std::byte, 16> async_result{};
+  auto readback =
+      transfer.readbackBufferAsync(storage, std::span(async_result));
+  REQUIRE(readback.isOk());
+  REQUIRE(transfer.wait(readback.value()).isOk());
+  REQUIRE(async_result == sync_result);
+}
+
+TEST_CASE("UploadBatch packs uploads into one staging buffer",
+          "[gpu][transfer]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  // Pin the staging path; direct-write destinations need no staging bytes
+  ctx.getPtrAllocator()->setDirectWriteEnabled(false);
+
+  auto first = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  auto second = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+
+  std::array<std::byte, 16> head{};
+  std::array<std::byte, 16> tail{};
+  head.fill(std::byte{0x11});
+  tail.fill(std::byte{0x22});
+
+  pandora::highlevel::UploadBatch batch{ctx};
+  REQUIRE(batch.add(first, std::span(head)).isOk());
+  REQUIRE(batch.add(first, std::span(tail), 32u).isOk());
+  REQUIRE(batch.add(second, std::span(tail)).isOk());
+  REQUIRE(batch.add(second, std::span(tail), 60u).isError());
+  REQUIRE(batch.getUploadCount() == 3u);
+  REQUIRE(batch.getStagingSize() >= 48u);
+
+  pandora::highlevel::TransferPlan plan{ctx};
+  REQUIRE(batch.record(plan).isOk());
+  REQUIRE(plan.submit().isOk());
+
+  CommandDriver driver{ctx, QueueFamilyType::Transfer};
+  driver.queueWaitIdle();
+
+  pandora::highlevel::ResourceTransfer transfer{ctx};
+  std::array<std::byte, 64> result{};
+  REQUIRE(transfer.readbackBuffer(first, std::span(result)).isOk());
+  REQUIRE(result.at(0) == std::byte{0x11});
+  REQUIRE(result.at(32) == std::byte{0x22});
+  batch.reset();
+}
+
+TEST_CASE("StagingRing reclaims regions once the timeline advances",
+          "[gpu][transfer]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  gpu::TimelineSemaphore timeline{ctx};
+  gpu::StagingRing ring{ctx, timeline, 4096u};
+
+  for (size_t idx = 0u; idx < 4u; idx += 1u) {
+    auto region = ring.reserve(ctx, 1024u);
+    REQUIRE(region.isOk());
+    REQUIRE(region.value().data.size_bytes() == 1024u);
+  }
+  // Nothing is in flight yet, so blocking could never make room
+  REQUIRE(ring.reserve(ctx, 1024u).isError());
+
+  ring.commit(1u);
+  REQUIRE(ring.getUsedSize() == 4096u);
+
+  TimelineSemaphoreDriver{}.setSemaphores({timeline}).setValues({1u}).signal(
+      ctx);
+
+  auto reused = ring.reserve(ctx, 1024u);
+  REQUIRE(reused.isOk());
+  REQUIRE(reused.value().offset == 0u);
+  REQUIRE(ring.getUsedSize() == 1024u);
+
+  gpu::StagingRing growing{ctx, timeline, 1024u, gpu::StagingRingPolicy::Grow};
+  REQUIRE(growing.reserve(ctx, 4096u).isOk());
+  REQUIRE(growing.getCapacity() >= 4096u);
+}
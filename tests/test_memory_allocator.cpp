@@ -0,0 +1,201 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <span>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "pandolabo.hpp"
+#include "pandora/core/gpu/vk_helper.hpp"
+#include "util/test_env.hpp"
+
+using namespace pandora::core;
+
+TEST_CASE("MemoryBlockMetadata respects alignment", "[gpu][allocator]") {
+  gpu::MemoryBlockMetadata metadata{1024u};
+
+  const auto first = metadata.allocate(10u, 1u);
+  REQUIRE(first.has_value());
+  REQUIRE(first.value() == 0u);
+
+  const auto second = metadata.allocate(64u, 256u);
+  REQUIRE(second.has_value());
+  REQUIRE(second.value() == 256u);
+
+  // The padding between the two ranges stays usable
+  const auto third = metadata.allocate(16u, 16u);
+  REQUIRE(third.has_value());
+  REQUIRE(third.value() == 16u);
+
+  REQUIRE(metadata.getFreeSize() == 1024u - 10u - 64u - 16u);
+  REQUIRE_FALSE(metadata.allocate(2048u, 1u).has_value());
+}
+
+TEST_CASE("MemoryBlockMetadata coalesces freed ranges", "[gpu][allocator]") {
+  gpu::MemoryBlockMetadata metadata{256u};
+
+  const auto a = metadata.allocate(64u, 1u);
+  const auto b = metadata.allocate(64u, 1u);
+  const auto c = metadata.allocate(128u, 1u);
+  REQUIRE((a && b && c));
+  REQUIRE_FALSE(metadata.allocate(1u, 1u).has_value());
+
+  metadata.free(a.value(), 64u);
+  metadata.free(c.value(), 128u);
+  // Two disjoint holes: neither fits 192 bytes
+  REQUIRE_FALSE(metadata.allocate(192u, 1u).has_value());
+
+  metadata.free(b.value(), 64u);
+  REQUIRE(metadata.isEmpty());
+
+  const auto whole = metadata.allocate(256u, 1u);
+  REQUIRE(whole.has_value());
+  REQUIRE(whole.value() == 0u);
+}
+
+TEST_CASE("Buffers share pooled device memory", "[gpu][allocator]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+  REQUIRE(ctx.getPtrAllocator() != nullptr);
+
+  std::vector<gpu::Buffer> buffers;
+  for (size_t i = 0u; i < 1000u; i += 1u) {
+    buffers.emplace_back(ctx,
+                         MemoryUsage::GpuOnly,
+                         TransferType::TransferDst,
+                         std::vector<BufferUsage>{BufferUsage::StorageBuffer},
+                         256u);
+  }
+
+  // A thousand small buffers fit in a handful of blocks
+  REQUIRE(ctx.getPtrAllocator()->getDeviceMemoryCount() < 8u);
+
+  gpu::Buffer dedicated{ctx,
+                        MemoryUsage::GpuOnly,
+                        TransferType::TransferDst,
+                        {BufferUsage::StorageBuffer},
+                        256u,
+                        AllocationStrategy::Dedicated};
+  REQUIRE(dedicated.getMemoryAllocation().isDedicated());
+  REQUIRE_FALSE(buffers.front().getMemoryAllocation().isDedicated());
+}
+
+TEST_CASE("Memory types are ranked with graceful fallback",
+          "[gpu][allocator]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const auto& memory_properties = ctx.getPtrDevice()->getMemoryProperties();
+  const auto& ptr_allocator = ctx.getPtrAllocator();
+  constexpr auto all_types = ~0u;
+
+  const auto upload_types = ptr_allocator->rankMemoryTypes(
+      all_types, vk_helper::getMemoryTypeRequest(MemoryUsage::CpuToGpu));
+  REQUIRE_FALSE(upload_types.empty());
+  REQUIRE(memory_properties.memoryTypes.at(upload_types.front()).propertyFlags
+          & vk::MemoryPropertyFlagBits::eHostVisible);
+
+  const auto device_types = ptr_allocator->rankMemoryTypes(
+      all_types, vk_helper::getMemoryTypeRequest(MemoryUsage::GpuOnly));
+  REQUIRE_FALSE(device_types.empty());
+  REQUIRE(memory_properties.memoryTypes.at(device_types.front()).propertyFlags
+          & vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+  // No type is allowed, so nothing qualifies
+  REQUIRE(ptr_allocator
+              ->rankMemoryTypes(
+                  0u, vk_helper::getMemoryTypeRequest(MemoryUsage::CpuToGpu))
+              .empty());
+}
+
+TEST_CASE("Host-visible buffers are persistently mapped", "[gpu][allocator]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  auto staging = createStagingBufferToGPU(ctx, 64u);
+  REQUIRE(staging.isPersistentlyMapped());
+  REQUIRE(staging.getMappedSpan().size_bytes() == 64u);
+  // mapMemory returns the cached address instead of mapping again
+  REQUIRE(staging.mapMemory(ctx) == staging.getMappedSpan().data());
+  staging.flushRange();
+  staging.unmapMemory(ctx);
+
+  // Device-local buffers are only mapped on the direct-write path
+  ctx.getPtrAllocator()->setDirectWriteEnabled(false);
+  auto storage = createStorageBuffer(ctx, TransferType::TransferDst, 64u);
+  REQUIRE_FALSE(storage.isPersistentlyMapped());
+  REQUIRE(storage.getMappedSpan().empty());
+}
+
+TEST_CASE("Direct-write path follows host-visible device-local heaps",
+          "[gpu][allocator]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const auto& ptr_allocator = ctx.getPtrAllocator();
+  REQUIRE(ptr_allocator->isDirectWriteAvailable()
+          == ptr_allocator->hasHostVisibleDeviceLocalHeap());
+
+  std::array<std::byte, 64> source{};
+  source.fill(std::byte{0x5a});
+  std::array<std::byte, 64> result{};
+  pandora::highlevel::ResourceTransfer transfer{ctx};
+
+  auto direct = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  REQUIRE(direct.isPersistentlyMapped()
+          == ptr_allocator->isDirectWriteAvailable());
+  REQUIRE(transfer.uploadBuffer(direct, std::span(source)).isOk());
+  REQUIRE(transfer.readbackBuffer(direct, std::span(result)).isOk());
+  REQUIRE(result == source);
+
+  // Forcing the classic path keeps device-local buffers unmapped
+  ptr_allocator->setDirectWriteEnabled(false);
+  REQUIRE_FALSE(ptr_allocator->isDirectWriteAvailable());
+  auto staged = createStorageBuffer(ctx, TransferType::TransferSrcDst, 64u);
+  REQUIRE_FALSE(staged.isPersistentlyMapped());
+  result.fill(std::byte{0});
+  REQUIRE(transfer.uploadBuffer(staged, std::span(source)).isOk());
+  REQUIRE(transfer.readbackBuffer(staged, std::span(result)).isOk());
+  REQUIRE(result == source);
+}
+
+TEST_CASE("FrameAllocator hands out aligned ranges and resets per frame",
+          "[gpu][allocator][highlevel]") {
+  PANDOLABO_REQUIRE_GPU_OR_SKIP();
+
+  std::shared_ptr<gpu_ui::WindowSurface> no_surface;
+  gpu::Context ctx{no_surface};
+  REQUIRE(ctx.isInitialized());
+
+  const auto min_alignment =
+      ctx.getPtrDevice()->getLimits().minUniformBufferOffsetAlignment;
+
+  pandora::highlevel::FrameAllocator frame_allocator{ctx, 4096u, 2u};
+  frame_allocator.reset(0u);
+
+  auto first = frame_allocator.allocate(12u);
+  auto second = frame_allocator.allocate(12u);
+  REQUIRE(first.isOk());
+  REQUIRE(second.isOk());
+  REQUIRE(second.value().offset % min_alignment == 0u);
+  REQUIRE(second.value().offset > first.value().offset);
+  REQUIRE(second.value().data.size_bytes() == 12u);
+
+  REQUIRE(frame_allocator.allocate(8192u).isError());
+
+  frame_allocator.reset(1u);
+  REQUIRE(frame_allocator.getUsedSize() == 0u);
+  REQUIRE(&frame_allocator.getBuffer() != &frame_allocator.getBuffer(0u));
+}
@@ -134,3 +134,30 @@ TEST_CASE("ClearColor and ClearDepthStencil setters", "[render][clear]") {
   REQUIRE(cds.depth == 1.0f);
   REQUIRE(cds.stencil == 255u);
 }
+
+TEST_CASE("GraphicInfo hash follows pipeline state", "[render][pipeline]") {
+  const auto make_info = [](CullMode cull_mode) {
+    pipeline::GraphicInfo info{};
+    info.input_assembly.setTopology(PrimitiveTopology::TriangleList);
+    info.rasterization.setCullMode(cull_mode);
+    info.rasterization.setLineWidth(1.0f);
+    info.dynamic_state.appendState(DynamicOption::Viewport);
+    return info;
+  };
+
+  const auto back = make_info(CullMode::Back);
+  REQUIRE(back.computeHash() == make_info(CullMode::Back).computeHash());
+  REQUIRE(back.computeHash() != make_info(CullMode::None).computeHash());
+
+  // Dynamic viewport does not take part in the hash
+  auto resized = make_info(CullMode::Back);
+  resized.viewport_state.setViewport({640.0f, 480.0f, 1.0f}, 0.0f, 1.0f);
+  REQUIRE(resized.computeHash() == back.computeHash());
+}
+
+TEST_CASE("HashBuilder resumes from an intermediate value", "[hash]") {
+  const auto full = HashBuilder{}.add(1u).add(2.0f).get();
+  const auto prefix = HashBuilder{}.add(1u).get();
+  REQUIRE(HashBuilder{prefix}.add(2.0f).get() == full);
+  REQUIRE(HashBuilder{}.add(2.0f).add(1u).get() != full);
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+
+#include "pandolabo.hpp"
+#include "util/compile_cache.hpp"
+
+using namespace pandora::core;
+
+namespace {
+
+constexpr auto COMPUTE_SHADER = R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] *= 2u; }
+)";
+
+std::string write_source(const std::string& file_name, const char* source) {
+  const auto path = std::filesystem::temp_directory_path() / file_name;
+  std::ofstream(path) << source;
+  return path.string();
+}
+
+}  // namespace
+
+TEST_CASE("Compiled SPIR-V is reused from the compile cache", "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_cache_test"};
+  const auto source_path =
+      write_source("pandolabo_spirv_cache_test.comp", COMPUTE_SHADER);
+
+  const auto compiled = io::shader::readText(source_path);
+  REQUIRE(compiled.isOk());
+  const auto entries = cache.getEntries();
+  REQUIRE(entries.size() == 1u);
+  REQUIRE(entries.front().extension() == ".spv");
+
+  const auto cached = io::shader::readText(source_path);
+  REQUIRE(cached.isOk());
+  REQUIRE(cached.value() == compiled.value());
+
+  // A truncated entry is ignored and replaced
+  std::filesystem::resize_file(entries.front(), 8u);
+  const auto recompiled = io::shader::readText(source_path);
+  REQUIRE(recompiled.isOk());
+  REQUIRE(recompiled.value() == compiled.value());
+  REQUIRE(std::filesystem::file_size(entries.front()) > 8u);
+}
+
+TEST_CASE("Edited shader source misses the compile cache", "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_cache_edit_test"};
+  const auto source_path =
+      write_source("pandolabo_spirv_cache_edit_test.comp", COMPUTE_SHADER);
+  REQUIRE(io::shader::readText(source_path).isOk());
+
+  write_source("pandolabo_spirv_cache_edit_test.comp",
+               R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] += 3u; }
+)");
+  REQUIRE(io::shader::readText(source_path).isOk());
+  REQUIRE(cache.getEntries().size() == 2u);
+}
+
+TEST_CASE("Empty compile cache directory disables the cache", "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_cache_disabled_test"};
+  io::shader::setCompileCacheDirectory({});
+  REQUIRE(io::shader::getCompileCacheDirectory().empty());
+
+  const auto source_path =
+      write_source("pandolabo_spirv_cache_disabled_test.comp", COMPUTE_SHADER);
+  REQUIRE(io::shader::readText(source_path).isOk());
+  REQUIRE_FALSE(std::filesystem::exists(cache.getDirectory()));
+}
+
+TEST_CASE("Compile cache is trimmed to its size limit", "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_cache_limit_test"};
+  const auto source_path =
+      write_source("pandolabo_spirv_cache_limit_test.comp", COMPUTE_SHADER);
+
+  REQUIRE(io::shader::readText(source_path).isOk());
+  REQUIRE(cache.getEntries().size() == 1u);
+  const auto entry_size =
+      std::filesystem::file_size(cache.getEntries().front());
+
+  // Room for one entry only: the older one is removed by the next write
+  io::shader::setCompileCacheSizeLimit(entry_size + entry_size / 2u);
+  write_source("pandolabo_spirv_cache_limit_test.comp",
+               R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] *= 3u; }
+)");
+  REQUIRE(io::shader::readText(source_path).isOk());
+  REQUIRE(cache.getEntries().size() == 1u);
+}
+
+TEST_CASE("Shaders are compiled in parallel with per-file results",
+          "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_compile_many_test"};
+
+  std::vector<std::string> source_paths;
+  for (uint32_t i = 0u; i < 6u; i += 1u) {
+    const auto source = std::string(R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+void main() { data.values[gl_GlobalInvocationID.x] += )")
+                        + std::to_string(i) + "u; }\n";
+    source_paths.push_back(write_source(
+        "pandolabo_compile_many_" + std::to_string(i) + ".comp",
+        source.c_str()));
+  }
+  source_paths.push_back(write_source("pandolabo_compile_many_broken.comp",
+                                      "#version 460\nvoid main() { x; }\n"));
+
+  const auto results = io::shader::compileMany(source_paths, 4u);
+  REQUIRE(results.size() == source_paths.size());
+  for (size_t i = 0u; i + 1u < results.size(); i += 1u) {
+    REQUIRE(results[i].isOk());
+    const auto expected = io::shader::readText(source_paths[i]);
+    REQUIRE(results[i].value() == expected.value());
+  }
+  REQUIRE(results.back().isError());
+
+  REQUIRE(io::shader::compileMany({}).empty());
+}
+
+TEST_CASE("Optimization stage output is cached beside plain SPIR-V",
+          "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_optimize_test"};
+  const auto source_path = write_source("pandolabo_spirv_optimize_test.comp",
+                                        R"(#version 460
+layout(local_size_x = 1) in;
+layout(set = 0, binding = 0) buffer Data { uint values[]; } data;
+uint unused_helper(uint x) { return x * 7u + 3u; }
+void main() {
+  uint scale = 2u;
+  if (scale == 3u) { data.values[0] = unused_helper(1u); }
+  data.values[gl_GlobalInvocationID.x] *= scale;
+}
+)");
+
+  const auto plain = io::shader::readText(source_path);
+  REQUIRE(plain.isOk());
+
+  const io::shader::CompileOptions options{.optimize = true,
+                                           .strip_debug_info = true};
+  const auto optimized = io::shader::readText(source_path, options);
+  REQUIRE(optimized.isOk());
+  REQUIRE(optimized.value().size() < plain.value().size());
+  REQUIRE(cache.getEntries().size() == 2u);
+
+  // Debug source info is gone, but names used by reflection remain
+  constexpr uint32_t OP_SOURCE = 3u;
+  constexpr uint32_t OP_NAME = 5u;
+  bool has_source = false;
+  bool has_name = false;
+  const auto& words = optimized.value();
+  for (size_t offset = 5u; offset < words.size();
+       offset += std::max(words[offset] >> 16u, 1u)) {
+    has_source |= (words[offset] & 0xffffu) == OP_SOURCE;
+    has_name |= (words[offset] & 0xffffu) == OP_NAME;
+  }
+  REQUIRE_FALSE(has_source);
+  REQUIRE(has_name);
+
+  const auto cached = io::shader::readText(source_path, options);
+  REQUIRE(cached.isOk());
+  REQUIRE(cached.value() == optimized.value());
+}
+
+TEST_CASE("Optimized precompiled SPIR-V is cached by content", "[shader]") {
+  const ScopedCompileCache cache{"pandolabo_spirv_binary_cache_test"};
+  const auto source_path =
+      write_source("pandolabo_spirv_binary_cache_test.comp", COMPUTE_SHADER);
+  const auto plain = io::shader::readText(source_path);
+  REQUIRE(plain.isOk());
+
+  const auto binary_path = (std::filesystem::temp_directory_path()
+                            / "pandolabo_spirv_binary_cache_test.spv")
+                               .string();
+  REQUIRE(io::shader::write(binary_path, plain.value()).isOk());
+  REQUIRE(io::shader::read(binary_path).isOk());
+  REQUIRE(cache.getEntries().size() == 1u);
+
+  const io::shader::CompileOptions options{.optimize = true};
+  const auto optimized = io::shader::read(binary_path, options);
+  REQUIRE(optimized.isOk());
+  REQUIRE(cache.getEntries().size() == 2u);
+
+  const auto cached = io::shader::read(binary_path, options);
+  REQUIRE(cached.isOk());
+  REQUIRE(cached.value() == optimized.value());
+  REQUIRE(cache.getEntries().size() == 2u);
+}
@@ -27,11 +27,13 @@ TEST_CASE("ImageSubInfo fluent setters", "[structures]") {
 TEST_CASE("DescriptorInfo fluent setters", "[structures]") {
   DescriptorInfo info{};
   info.setStageFlags(vk::ShaderStageFlagBits::eVertex)
+      .setSet(1)
       .setBinding(3)
       .setType(vk::DescriptorType::eUniformBuffer)
       .setSize(2);
 
   REQUIRE(info.stage_flags == vk::ShaderStageFlagBits::eVertex);
+  REQUIRE(info.set == 1u);
   REQUIRE(info.binding == 3u);
   REQUIRE(info.type == vk::DescriptorType::eUniformBuffer);
   REQUIRE(info.size == 2u);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "pandora/core/io.hpp"
+
+/// @brief Point the compile cache at a fresh directory for one test
+/// @details The previous directory and size limit are restored and the
+/// directory is removed on destruction, even if the test fails early.
+class ScopedCompileCache {
+ private:
+  std::filesystem::path m_previousDirectory;
+  uint64_t m_previousSizeLimit;
+  std::filesystem::path m_directory;
+
+ public:
+  explicit ScopedCompileCache(const std::string& name)
+      : m_previousDirectory(
+            pandora::core::io::shader::getCompileCacheDirectory()),
+        m_previousSizeLimit(
+            pandora::core::io::shader::getCompileCacheSizeLimit()),
+        m_directory(std::filesystem::temp_directory_path() / name) {
+    std::filesystem::remove_all(m_directory);
+    pandora::core::io::shader::setCompileCacheDirectory(m_directory);
+  }
+
+  ~ScopedCompileCache() {
+    pandora::core::io::shader::setCompileCacheDirectory(m_previousDirectory);
+    pandora::core::io::shader::setCompileCacheSizeLimit(m_previousSizeLimit);
+    std::error_code error_code;
+    std::filesystem::remove_all(m_directory, error_code);
+  }
+
+  ScopedCompileCache(const ScopedCompileCache&) = delete;
+  ScopedCompileCache& operator=(const ScopedCompileCache&) = delete;
+
+  const auto& getDirectory() const {
+    return m_directory;
+  }
+
+  std::vector<std::filesystem::path> getEntries() const {
+    std::vector<std::filesystem::path> entries;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(m_directory)) {
+      entries.push_back(entry.path());
+    }
+    return entries;
+  }
+};